@@ -0,0 +1,55 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "src/classifiers.h"
+
+#define BENCH_COMPLEXITY_SIMPLE   0
+#define BENCH_COMPLEXITY_COMPOUND 1
+#define BENCH_COMPLEXITY_NESTED   2
+
+struct GeneratorOptions {
+	size_t count;
+	int complexity;
+	int nbsp_percent;
+	int describe;
+	uint64_t seed;
+};
+
+extern void generate_rpm_output(FILE *out, const struct GeneratorOptions *opts);
+extern void generate_version(char *buffer, size_t bufsize, uint64_t *rng);
+
+extern uint64_t bench_random(uint64_t *state);
+extern uint64_t bench_now(void);
+extern double bench_median(double *samples, size_t count);
+
+extern void bench_silence_stdout(void);
+extern void bench_restore_stdout(void);
+
+extern const char* bench_grammarName(int grammar);
+extern struct LicenceClassifier* bench_newClassifier(int grammar, const struct LicenceData *data);
+
+extern int bench_classifiers(int argc, char **argv);
+extern int bench_packages(int argc, char **argv);
+extern int bench_versions(int argc, char **argv);
+
+#endif
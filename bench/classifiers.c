@@ -0,0 +1,304 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench/bench.h"
+#include "src/buffers.h"
+#include "src/builtin-licences.h"
+#include "src/classifiers.h"
+#include "src/licences.h"
+#include "src/options.h"
+#include "src/stats.h"
+#include "src/stringutils.h"
+
+#define LICENCES_DIR   "licences"
+#define FUZZ_INPUT_DIR "test/fuzz/input"
+#define REPETITIONS 7
+
+// Expressions modelled after the ones seen in the test suite, using real licence names.
+static const char *const expressions[] = {
+	"MIT",
+	"GPLv2+",
+	"GPL-2.0-or-later",
+	"Absolutely Proprietary (eww)",
+	"MIT and BSD",
+	"MIT AND Apache-2.0",
+	"MIT or Apache-2.0",
+	"GPLv2+ or Artistic",
+	"GPL-3.0-only WITH GCC-exception-3.1",
+	"GPLv2 with exceptions",
+	"LGPLv2+ with linking exception",
+	"GPL-2.0-or-later+",
+	"(MIT OR Apache-2.0) AND Unicode-DFS-2016",
+	"(GPLv2 or Artistic) and MIT",
+	"(MIT OR Apache-2.0)AND(BSD-2-Clause OR Zlib)",
+	"((MIT))",
+	"(((GPL-2.0-only)))",
+	"MIT AND Proprietary OR Apache-2.0 AND BSD-3-Clause",
+	"Proprietary or Redistributable, no modification permitted",
+	"LGPLv2+ and GPLv2+ and (GPLv2+ or LGPLv3+) and BSD and MIT and Public Domain",
+	"( ( Proprietary OR MIT ) AND Unknown ) OR ( Nonfree AND Apache-2.0 )",
+	"(Apache-2.0 OR MIT) AND (Apache-2.0 WITH LLVM-exception OR Apache-2.0 OR MIT) AND BSD-3-Clause AND (MIT OR Unlicense)",
+	"BSD and GPLv2 and GPLv2+ and LGPLv2+ and MIT and (MPLv1.1 or GPLv2+ or LGPLv2+) and Copyright only",
+	"(MIT",
+	"MIT)",
+	"(MIT AND ) OR",
+};
+
+struct Corpus {
+	const char *name;
+	struct ReBuffer *list;
+	struct ChainBuffer *text;
+	size_t total_len;
+};
+
+#define CORPUS_COUNT(corpus)   ((corpus)->list->used / sizeof(char*))
+#define CORPUS_ITEM(corpus, i) (((char**)(corpus)->list->data)[(i)])
+
+static int corpus_init(struct Corpus *corpus, const char *name) {
+	corpus->name = name;
+	corpus->list = rebuf_init(512 * sizeof(char*));
+	corpus->text = chainbuf_init(16256);
+	corpus->total_len = 0;
+	return ((corpus->list != NULL) && (corpus->text != NULL)) ? 0 : -1;
+}
+
+static void corpus_free(struct Corpus *corpus) {
+	rebuf_free(corpus->list);
+	chainbuf_free(corpus->text);
+}
+
+static int corpus_add(struct Corpus *corpus, const char *item) {
+	char *copy = chainbuf_append(&corpus->text, item);
+	if(copy == NULL) return -1;
+	if(rebuf_append(corpus->list, &copy, sizeof(char*)) == NULL) return -1;
+
+	corpus->total_len += strlen(item) + 1;
+	return 0;
+}
+
+// Sanitise the string the same way packages_read() does, then add it to the corpus.
+static int corpus_addFromFile(struct Corpus *corpus, const char *path, int whole_file) {
+	FILE *f = fopen(path, "r");
+	if(f == NULL) return -1;
+
+	char line[1024], sanitised[1024];
+	int result = 0;
+	while(fgets(line, sizeof(line), f) != NULL) {
+		str_squeeze_char(line, ' ');
+		char *trimmed = trim(line, NULL);
+		if(*trimmed == '\0') continue;
+
+		str_balance_parentheses(trimmed, sanitised, sizeof(sanitised), NULL);
+		result = corpus_add(corpus, sanitised);
+		if((result != 0) || whole_file) break;
+	}
+
+	fclose(f);
+	return result;
+}
+
+static int compare_strings(const void *A, const void *B) {
+	return strcmp(*(char *const *)A, *(char *const *)B);
+}
+
+// Get the names of all the licence lists (or all the fuzz inputs), sorted, so the output order is stable.
+static struct ReBuffer* list_dir(const char *path, const char *suffix, struct ChainBuffer **names) {
+	DIR *dir = opendir(path);
+	if(dir == NULL) return NULL;
+
+	struct ReBuffer *list = rebuf_init(16 * sizeof(char*));
+	if(list == NULL) {
+		closedir(dir);
+		return NULL;
+	}
+
+	struct dirent *entry;
+	while((entry = readdir(dir)) != NULL) {
+		if(entry->d_name[0] == '.') continue;
+
+		char *end = (suffix != NULL) ? str_ends_with(entry->d_name, suffix) : NULL;
+		if((suffix != NULL) && (end == NULL)) continue;
+
+		const char oldChar = (end != NULL) ? *end : '\0';
+		if(end != NULL) *end = '\0';
+		char *name = chainbuf_append(names, entry->d_name);
+		if(end != NULL) *end = oldChar;
+
+		if((name == NULL) || (rebuf_append(list, &name, sizeof(char*)) == NULL)) {
+			rebuf_free(list);
+			closedir(dir);
+			return NULL;
+		}
+	}
+	closedir(dir);
+
+	qsort(list->data, list->used / sizeof(char*), sizeof(char*), &compare_strings);
+	return list;
+}
+
+static void run_corpus(const char *grammar, const char *listname, struct LicenceClassifier *classifier, const struct Corpus *corpus) {
+	const size_t count = CORPUS_COUNT(corpus);
+	if(count == 0) return;
+
+	// The classifiers modify the strings they're given, so each repetition needs fresh copies.
+	char *scratch = malloc(corpus->total_len);
+	char **input = malloc(count * sizeof(char*));
+	struct LicenceTreeNode **output = malloc(count * sizeof(struct LicenceTreeNode*));
+	if((scratch == NULL) || (input == NULL) || (output == NULL)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free(scratch);
+		free(input);
+		free(output);
+		return;
+	}
+
+	double ns[REPETITIONS];
+	unsigned long mallocs = 0, depth = 0;
+	for(int r = 0; r < REPETITIONS; ++r) {
+		char *pos = scratch;
+		for(size_t i = 0; i < count; ++i) {
+			const size_t len = strlen(CORPUS_ITEM(corpus, i)) + 1;
+			memcpy(pos, CORPUS_ITEM(corpus, i), len);
+			input[i] = pos;
+			pos += len;
+		}
+
+		const unsigned long mallocs_before = stats_counter[STATS_COUNTER_TREE_NODE_MALLOCS];
+		stats_counter[STATS_COUNTER_CLASSIFIER_DEPTH] = 0;
+
+		const uint64_t start = bench_now();
+		for(size_t i = 0; i < count; ++i) output[i] = classifier->classify(classifier, input[i]);
+		const uint64_t end = bench_now();
+
+		mallocs = stats_counter[STATS_COUNTER_TREE_NODE_MALLOCS] - mallocs_before;
+		depth = stats_counter[STATS_COUNTER_CLASSIFIER_DEPTH];
+		ns[r] = (double)(end - start) / count;
+
+		for(size_t i = 0; i < count; ++i) licence_freeTree(output[i]);
+	}
+
+	printf(
+		"%-13s %-17s %-12s %8zu %12.1f %12.2f %10lu\n",
+		grammar,
+		listname,
+		corpus->name,
+		count,
+		bench_median(ns, REPETITIONS),
+		(double)mallocs / count,
+		depth
+	);
+
+	free(output);
+	free(input);
+	free(scratch);
+}
+
+int bench_classifiers(int argc, char **argv) {
+	(void)argc;
+	(void)argv;
+
+	int result = 1;
+	struct ChainBuffer *names = chainbuf_init(4096);
+	struct ReBuffer *lists = NULL, *fuzz_inputs = NULL;
+	struct Corpus corpora[2];
+	int corpora_ok = 0;
+
+	if(names == NULL) goto end;
+	lists = list_dir(LICENCES_DIR, ".txt", &names);
+	if(lists == NULL) {
+		fprintf(stderr, "Failed to list the \"" LICENCES_DIR "\" directory - run the benchmark from the project root\n");
+		goto end;
+	}
+	fuzz_inputs = list_dir(FUZZ_INPUT_DIR, NULL, &names);
+
+	if((corpus_init(&corpora[0], "names") != 0) || (corpus_init(&corpora[1], "expressions") != 0)) goto end;
+	corpora_ok = 1;
+
+	// The "names" corpus contains all the licence names from all the lists - so, depending on the list used,
+	// some of them will be classified as free, and some as non-free.
+	const size_t list_count = lists->used / sizeof(char*);
+	for(size_t l = 0; l < list_count; ++l) {
+		char path[256];
+		snprintf(path, sizeof(path), LICENCES_DIR "/%s.txt", ((char**)lists->data)[l]);
+
+		FILE *f = fopen(path, "r");
+		if(f == NULL) continue;
+
+		char line[256];
+		while(fgets(line, sizeof(line), f) != NULL) {
+			char *trimmed = trim(line, NULL);
+			if((*trimmed != '\0') && (corpus_add(&corpora[0], trimmed) != 0)) break;
+		}
+		fclose(f);
+	}
+
+	for(size_t e = 0; e < sizeof(expressions) / sizeof(expressions[0]); ++e) {
+		if(corpus_add(&corpora[1], expressions[e]) != 0) goto end;
+	}
+	if(fuzz_inputs != NULL) {
+		for(size_t i = 0; i < fuzz_inputs->used / sizeof(char*); ++i) {
+			char path[256];
+			snprintf(path, sizeof(path), FUZZ_INPUT_DIR "/%s", ((char**)fuzz_inputs->data)[i]);
+			corpus_addFromFile(&corpora[1], path, 1);
+		}
+	}
+
+	printf("# classifiers: median ns per classification, tree node allocations per classification, deepest recursion\n");
+	printf("%-13s %-17s %-12s %8s %12s %12s %10s\n", "grammar", "list", "corpus", "strings", "ns", "allocs", "depth");
+
+	const int grammars[] = { OPT_GRAMMAR_LOOSE, OPT_GRAMMAR_SPDX_STRICT, OPT_GRAMMAR_SPDX_LENIENT };
+	for(size_t g = 0; g < sizeof(grammars) / sizeof(grammars[0]); ++g) {
+		for(size_t l = 0; l < list_count; ++l) {
+			const char *listname = ((char**)lists->data)[l];
+
+			// Use the built-in list when possible, since that's what the program does.
+			char path[256];
+			if(strcmp(listname, BUILTIN_LICENCE_LIST) == 0)
+				snprintf(path, sizeof(path), "%s", listname);
+			else
+				snprintf(path, sizeof(path), "./" LICENCES_DIR "/%s.txt", listname);
+			struct LicenceData *data = licences_read(path);
+			struct LicenceClassifier *classifier = (data != NULL) ? bench_newClassifier(grammars[g], data) : NULL;
+			if(classifier == NULL) {
+				fprintf(stderr, "Failed to set up the classifier for list \"%s\"\n", listname);
+				licences_free(data);
+				continue;
+			}
+
+			for(int c = 0; c < 2; ++c) run_corpus(bench_grammarName(grammars[g]), listname, classifier, &corpora[c]);
+			fflush(stdout);
+
+			classifier->free(classifier);
+			licences_free(data);
+		}
+	}
+	result = 0;
+
+	end:
+	if(corpora_ok) {
+		corpus_free(&corpora[0]);
+		corpus_free(&corpora[1]);
+	}
+	rebuf_free(fuzz_inputs);
+	rebuf_free(lists);
+	chainbuf_free(names);
+	return result;
+}
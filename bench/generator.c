@@ -0,0 +1,171 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "bench/bench.h"
+
+#define ARRAY_LEN(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+static const char *const name_prefixes[] = {
+	"", "", "", "", "lib", "python3-", "perl-", "golang-github-", "rust-", "texlive-", "ghc-", "mingw64-",
+};
+
+static const char *const name_syllables[] = {
+	"ac", "bar", "cor", "dat", "el", "fon", "gio", "hal", "in", "jar", "ker", "lo",
+	"mat", "net", "ox", "pul", "qua", "ran", "sol", "tor", "ur", "vex", "wa", "zen",
+};
+
+static const char *const name_suffixes[] = {
+	"", "", "", "", "", "-devel", "-libs", "-doc", "-common", "-tools", "-data",
+};
+
+static const char *const arches[] = {
+	"x86_64", "x86_64", "x86_64", "noarch", "noarch", "i686",
+};
+
+static const char *const simple_licences[] = {
+	"MIT",
+	"GPL-2.0-or-later",
+	"GPL-3.0-only",
+	"LGPL-2.1-or-later",
+	"BSD-3-Clause",
+	"Apache-2.0",
+	"GPLv2+",
+	"LGPLv2+",
+	"ASL 2.0",
+	"Public Domain",
+	"Zlib",
+	"OFL",
+	"Proprietary",
+	"Redistributable, no modification permitted",
+};
+
+static const char *const compound_licences[] = {
+	"GPLv2+ and LGPLv2+",
+	"MIT and BSD",
+	"(GPLv2 or Artistic) and MIT",
+	"GPL-2.0-or-later AND LGPL-2.1-or-later",
+	"Apache-2.0 OR MIT",
+	"LGPLv2+ and GPLv2+ with exceptions",
+	"GPL-3.0-or-later WITH Bison-exception-2.2",
+	"BSD-2-Clause AND LicenseRef-Nonfree",
+	"GPL+ or Artistic",
+	"MPL-2.0 AND (LGPL-2.1-or-later OR GPL-2.0-or-later)",
+};
+
+static const char *const nested_licences[] = {
+	"(MIT OR Apache-2.0) AND Unicode-DFS-2016 AND (BSD-2-Clause OR (Zlib AND ISC))",
+	"GPLv2+ and LGPLv2+ and (GPLv2+ or LGPLv3+) and BSD and MIT and Public Domain",
+	"(Apache-2.0 OR MIT) AND (Apache-2.0 WITH LLVM-exception OR Apache-2.0 OR MIT) AND BSD-3-Clause AND (MIT OR Unlicense)",
+	"LGPLv2+ and (GPLv2+ or (LGPLv3+ and (MIT or Proprietary))) and Redistributable, no modification permitted",
+	"((GPL-2.0-only WITH Linux-syscall-note) OR BSD-2-Clause) AND (GPL-2.0-only OR MIT) AND LicenseRef-Fedora-Firmware",
+	"BSD and GPLv2 and GPLv2+ and LGPLv2+ and MIT and (MPLv1.1 or GPLv2+ or LGPLv2+) and Copyright only",
+};
+
+static const char *const summaries[] = {
+	"Library for handling things",
+	"Command-line tool for doing stuff",
+	"Development files for the library",
+	"Documentation in HTML format",
+	"Fonts for rendering text on the screen",
+	"Python bindings for the library",
+};
+
+#define PICK(rng, arr)  ((arr)[bench_random(rng) % ARRAY_LEN(arr)])
+
+// rpm reports some fields with non-breaking spaces in them,
+// which vrms-rpm has to normalise before parsing.
+static void put_text(FILE *out, const char *text, int nbsp_percent, uint64_t *rng) {
+	for(; *text != '\0'; ++text) {
+		if((*text == ' ') && ((int)(bench_random(rng) % 100) < nbsp_percent))
+			fputs("\xC2\xA0", out);
+		else
+			putc(*text, out);
+	}
+}
+
+static void make_name(char *buffer, size_t bufsize, uint64_t *rng) {
+	char stem[64] = "";
+	const int syllables = 2 + (bench_random(rng) % 3);
+	for(int s = 0; s < syllables; ++s) strcat(stem, PICK(rng, name_syllables));
+
+	snprintf(buffer, bufsize, "%s%s%s", PICK(rng, name_prefixes), stem, PICK(rng, name_suffixes));
+}
+
+// Produce a version string. Most of these are plain "x.y.z",
+// but date-based versions and pre-/post-release markers are also included.
+void generate_version(char *buffer, size_t bufsize, uint64_t *rng) {
+	switch(bench_random(rng) % 8) {
+		case 0:
+			snprintf(buffer, bufsize, "%u", (unsigned)(20180101 + (bench_random(rng) % 60000)));
+		break;
+		case 1:
+			snprintf(buffer, bufsize, "%u.%u~rc%u", (unsigned)(bench_random(rng) % 10), (unsigned)(bench_random(rng) % 30), (unsigned)(1 + bench_random(rng) % 4));
+		break;
+		case 2:
+			snprintf(buffer, bufsize, "%u.%u^%ugit%06x", (unsigned)(bench_random(rng) % 10), (unsigned)(bench_random(rng) % 30), (unsigned)(20200101 + bench_random(rng) % 40000), (unsigned)(bench_random(rng) & 0xFFFFFF));
+		break;
+		default:
+			snprintf(buffer, bufsize, "%u.%u.%u", (unsigned)(bench_random(rng) % 10), (unsigned)(bench_random(rng) % 100), (unsigned)(bench_random(rng) % 20));
+		break;
+	}
+}
+
+static const char* pick_licence(int complexity, uint64_t *rng) {
+	const int kind = bench_random(rng) % (complexity + 1);
+	if(kind == BENCH_COMPLEXITY_NESTED) return PICK(rng, nested_licences);
+	if(kind == BENCH_COMPLEXITY_COMPOUND) return PICK(rng, compound_licences);
+	return PICK(rng, simple_licences);
+}
+
+/*
+ * Emit rpm query output, in the format requested by packages_openPipe().
+ * About 5% of the packages re-use the previous name, to mimic multilib installs
+ * and make sure the --evra auto logic gets exercised.
+ */
+void generate_rpm_output(FILE *out, const struct GeneratorOptions *opts) {
+	uint64_t rng = opts->seed ? opts->seed : 0x9E3779B97F4A7C15ULL;
+	char name[128] = "";
+
+	for(size_t i = 0; i < opts->count; ++i) {
+		if((i == 0) || ((bench_random(&rng) % 100) >= 5)) make_name(name, sizeof(name), &rng);
+
+		fputs(name, out);
+		if((bench_random(&rng) % 10) == 0)
+			fprintf(out, "\t%u\t", (unsigned)(1 + bench_random(&rng) % 3));
+		else
+			fputs("\t(none)\t", out);
+
+		char version[64];
+		generate_version(version, sizeof(version), &rng);
+		fputs(version, out);
+		fprintf(out, "\t%u.fc%u\t%s\t0\t", (unsigned)(1 + bench_random(&rng) % 20), (unsigned)(36 + bench_random(&rng) % 4), PICK(&rng, arches));
+		put_text(out, pick_licence(opts->complexity, &rng), opts->nbsp_percent, &rng);
+
+		if(opts->describe) {
+			putc('\t', out);
+			put_text(out, PICK(&rng, summaries), opts->nbsp_percent, &rng);
+		}
+		putc('\n', out);
+	}
+
+	// Every rpmdb has got at least one of these.
+	fputs("gpg-pubkey\t(none)\teb10b464\t6202d9c6\t(none)\t1\tpubkey", out);
+	if(opts->describe) fputs("\tgpg(Fedora (39) <fedora-39-primary@fedoraproject.org>)", out);
+	putc('\n', out);
+}
@@ -0,0 +1,56 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "bench/bench.h"
+
+static void print_usage(const char *self) {
+	fprintf(stderr, "Usage: %s [MODE [ARGS...]]\n", self);
+	fprintf(stderr, "Available modes:\n");
+	fprintf(stderr, "  classifiers\n");
+	fprintf(stderr, "    Measure the cost of each licence classifier, using each of the licence lists,\n");
+	fprintf(stderr, "    against the names found in the lists and a set of real-world expressions.\n");
+	fprintf(stderr, "    Must be run from the project root.\n");
+	fprintf(stderr, "  packages [COUNT...]\n");
+	fprintf(stderr, "    Measure packages_read(), packages_sort() and packages_list() throughput\n");
+	fprintf(stderr, "    on synthetic rpm output. Default counts: 1000 10000 100000.\n");
+	fprintf(stderr, "  versions [COUNT...]\n");
+	fprintf(stderr, "    Measure the cost of sorting version strings using the built-in comparators\n");
+	fprintf(stderr, "    (plain and pre-tokenised) and rpmvercmp(), when built with librpm.\n");
+	fprintf(stderr, "    Default counts: 10000 100000 1000000.\n");
+	fprintf(stderr, "When no mode is given, all of them are run with default settings.\n");
+}
+
+int main(int argc, char **argv) {
+	if(argc < 2) {
+		int result = bench_packages(0, NULL);
+		putc('\n', stdout);
+		result |= bench_classifiers(0, NULL);
+		putc('\n', stdout);
+		result |= bench_versions(0, NULL);
+		return result;
+	}
+
+	const char *mode = argv[1];
+	if(strcmp(mode, "classifiers") == 0) return bench_classifiers(argc - 2, argv + 2);
+	if(strcmp(mode, "packages") == 0) return bench_packages(argc - 2, argv + 2);
+	if(strcmp(mode, "versions") == 0) return bench_versions(argc - 2, argv + 2);
+
+	print_usage(argv[0]);
+	return 1;
+}
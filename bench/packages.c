@@ -0,0 +1,141 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench/bench.h"
+#include "src/classifiers.h"
+#include "src/licences.h"
+#include "src/options.h"
+#include "src/packages.h"
+
+#define NBSP_PERCENT 10
+
+static const char *const complexity_name[] = {
+	"simple",
+	"compound",
+	"nested",
+};
+
+static int run_config(const size_t count, const int complexity, struct LicenceClassifier *classifier) {
+	FILE *input = tmpfile();
+	if(input == NULL) {
+		perror("tmpfile");
+		return -1;
+	}
+
+	const struct GeneratorOptions opts = {
+		.count = count,
+		.complexity = complexity,
+		.nbsp_percent = NBSP_PERCENT,
+		.describe = opt_describe,
+		.seed = 0,
+	};
+	generate_rpm_output(input, &opts);
+
+	// Keep the total run time in check for the largest inputs.
+	const int repetitions = (count >= 1000000) ? 3 : (count >= 100000) ? 5 : 9;
+	double read_ns[9], sort_ns[9], list_ns[9];
+
+	for(int r = 0; r < repetitions; ++r) {
+		rewind(input);
+
+		const uint64_t start = bench_now();
+		if(packages_readFile(input, classifier) < 0) {
+			fprintf(stderr, "packages_readFile() failed\n");
+			fclose(input);
+			return -1;
+		}
+		const uint64_t after_read = bench_now();
+
+		packages_sort();
+		const uint64_t after_sort = bench_now();
+
+		bench_silence_stdout();
+		packages_list();
+		bench_restore_stdout();
+		const uint64_t after_list = bench_now();
+
+		packages_free();
+
+		// +1 for the gpg-pubkey package
+		read_ns[r] = (double)(after_read - start) / (count + 1);
+		sort_ns[r] = (double)(after_sort - after_read) / (count + 1);
+		list_ns[r] = (double)(after_list - after_sort) / (count + 1);
+	}
+	fclose(input);
+
+	printf(
+		"%10zu  %-10s %14.1f %14.1f %14.1f\n",
+		count,
+		complexity_name[complexity],
+		bench_median(read_ns, repetitions),
+		bench_median(sort_ns, repetitions),
+		bench_median(list_ns, repetitions)
+	);
+	fflush(stdout);
+	return 0;
+}
+
+int bench_packages(int argc, char **argv) {
+	size_t default_counts[] = { 1000, 10000, 100000 };
+	size_t *counts = default_counts;
+	size_t count_num = sizeof(default_counts) / sizeof(default_counts[0]);
+
+	if(argc > 0) {
+		counts = malloc(argc * sizeof(size_t));
+		if(counts == NULL) return 1;
+
+		for(int i = 0; i < argc; ++i) counts[i] = strtoul(argv[i], NULL, 10);
+		count_num = argc;
+	}
+
+	// Print everything, in a stable manner, regardless of the terminal.
+	opt_colour = 0;
+	opt_list = OPT_LIST_FREE | OPT_LIST_NONFREE;
+
+	struct LicenceData *licences = licences_read(opt_licencelist[0]);
+	struct LicenceClassifier *classifier = (licences != NULL) ? bench_newClassifier(opt_grammar, licences) : NULL;
+	if(classifier == NULL) {
+		fprintf(stderr, "Failed to set up the licence classifier\n");
+		licences_free(licences);
+		if(counts != default_counts) free(counts);
+		return 1;
+	}
+
+	#ifdef WITH_LIBRPM
+		const char *vercmp = "librpm";
+	#else
+		const char *vercmp = "tokens";
+	#endif
+	printf("# packages: licence list = %s, grammar = %s, version comparison = %s\n", opt_licencelist[0], bench_grammarName(opt_grammar), vercmp);
+	printf("# median ns per package, %d%% of spaces replaced with NBSP\n", NBSP_PERCENT);
+	printf("%10s  %-10s %14s %14s %14s\n", "packages", "licences", "read", "sort", "list");
+
+	int result = 0;
+	for(size_t c = 0; (c < count_num) && (result == 0); ++c) {
+		for(int complexity = BENCH_COMPLEXITY_SIMPLE; complexity <= BENCH_COMPLEXITY_NESTED; ++complexity) {
+			result = run_config(counts[c], complexity, classifier);
+			if(result != 0) break;
+		}
+	}
+
+	classifier->free(classifier);
+	licences_free(licences);
+	if(counts != default_counts) free(counts);
+	return (result == 0) ? 0 : 1;
+}
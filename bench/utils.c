@@ -0,0 +1,97 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench/bench.h"
+#include "src/options.h"
+
+// xorshift64* - we don't need anything fancy, just a sequence that's
+// identical between runs, so the benchmark numbers stay comparable.
+uint64_t bench_random(uint64_t *state) {
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+uint64_t bench_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_doubles(const void *A, const void *B) {
+	const double a = *(const double*)A;
+	const double b = *(const double*)B;
+	return (a > b) - (a < b);
+}
+
+double bench_median(double *samples, size_t count) {
+	qsort(samples, count, sizeof(double), &compare_doubles);
+	if(count % 2) return samples[count / 2];
+	return (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+}
+
+static int saved_stdout = -1;
+
+void bench_silence_stdout(void) {
+	fflush(stdout);
+	saved_stdout = dup(fileno(stdout));
+
+	int devnull = open("/dev/null", O_WRONLY);
+	if(devnull >= 0) {
+		dup2(devnull, fileno(stdout));
+		close(devnull);
+	}
+}
+
+void bench_restore_stdout(void) {
+	fflush(stdout);
+	if(saved_stdout >= 0) {
+		dup2(saved_stdout, fileno(stdout));
+		close(saved_stdout);
+		saved_stdout = -1;
+	}
+}
+
+const char* bench_grammarName(int grammar) {
+	switch(grammar) {
+		case OPT_GRAMMAR_LOOSE: return "loose";
+		case OPT_GRAMMAR_SPDX_STRICT: return "spdx-strict";
+		case OPT_GRAMMAR_SPDX_LENIENT: return "spdx-lenient";
+		default: return "???";
+	}
+}
+
+struct LicenceClassifier* bench_newClassifier(int grammar, const struct LicenceData *data) {
+	switch(grammar) {
+		case OPT_GRAMMAR_LOOSE:
+			return classifier_newLoose(&data, 1);
+		case OPT_GRAMMAR_SPDX_STRICT:
+			return classifier_newSPDX(&data, 1, 0);
+		case OPT_GRAMMAR_SPDX_LENIENT:
+			return classifier_newSPDX(&data, 1, 1);
+		default:
+			return NULL;
+	}
+}
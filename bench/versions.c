@@ -0,0 +1,140 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench/bench.h"
+#include "src/versions.h"
+
+#ifdef WITH_LIBRPM
+#include <rpm/rpmio.h>
+#include <rpm/rpmlib.h>
+#endif
+
+#define VERSION_LEN 64
+#define TOKENS_LEN  TOKENISED_EVR_MAX_SIZE(0, VERSION_LEN, 0)
+#define REPETITIONS 5
+
+static int qsort_fallback(const void *A, const void *B) {
+	return compare_versions_fallback(*(char *const *)A, *(char *const *)B);
+}
+
+static int qsort_tokens(const void *A, const void *B) {
+	return versions_compareTokens(*(const unsigned char *const *)A, *(const unsigned char *const *)B);
+}
+
+#ifdef WITH_LIBRPM
+static int qsort_rpmvercmp(const void *A, const void *B) {
+	return rpmvercmp(*(char *const *)A, *(char *const *)B);
+}
+#endif
+
+// The "tokens" comparator works on versions tokenised beforehand, which is what
+// packages_sort() does in builds without librpm. Tokenisation happens once per package,
+// when reading the package list, so it's reported separately, in the "prepare" column.
+static const struct {
+	const char *name;
+	int(*compare)(const void*, const void*);
+	int tokenised;
+} comparators[] = {
+	{ "fallback", &qsort_fallback, 0 },
+	{ "tokens", &qsort_tokens, 1 },
+	#ifdef WITH_LIBRPM
+		{ "rpmvercmp", &qsort_rpmvercmp, 0 },
+	#endif
+};
+
+static int run_config(const size_t count) {
+	char *storage = malloc(count * VERSION_LEN);
+	unsigned char *token_storage = malloc(count * TOKENS_LEN);
+	void **versions = malloc(count * sizeof(void*));
+	void **tokens = malloc(count * sizeof(void*));
+	void **sorted = malloc(count * sizeof(void*));
+	if((storage == NULL) || (token_storage == NULL) || (versions == NULL) || (tokens == NULL) || (sorted == NULL)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free(storage);
+		free(token_storage);
+		free(versions);
+		free(tokens);
+		free(sorted);
+		return -1;
+	}
+
+	uint64_t rng = 0x9E3779B97F4A7C15ULL;
+	for(size_t i = 0; i < count; ++i) {
+		versions[i] = storage + (i * VERSION_LEN);
+		generate_version(versions[i], VERSION_LEN, &rng);
+		tokens[i] = token_storage + (i * TOKENS_LEN);
+	}
+
+	double tokenise_ns[REPETITIONS];
+	for(int r = 0; r < REPETITIONS; ++r) {
+		const uint64_t start = bench_now();
+		for(size_t i = 0; i < count; ++i) versions_tokenise(NULL, versions[i], "", tokens[i], TOKENS_LEN);
+		const uint64_t end = bench_now();
+
+		tokenise_ns[r] = (double)(end - start) / count;
+	}
+	const double prepare = bench_median(tokenise_ns, REPETITIONS);
+
+	for(size_t c = 0; c < sizeof(comparators) / sizeof(comparators[0]); ++c) {
+		double ns[REPETITIONS];
+		for(int r = 0; r < REPETITIONS; ++r) {
+			memcpy(sorted, comparators[c].tokenised ? tokens : versions, count * sizeof(void*));
+
+			const uint64_t start = bench_now();
+			qsort(sorted, count, sizeof(void*), comparators[c].compare);
+			const uint64_t end = bench_now();
+
+			ns[r] = (double)(end - start) / count;
+		}
+
+		printf("%10zu  %-10s %14.1f %14.1f\n", count, comparators[c].name, comparators[c].tokenised ? prepare : 0.0, bench_median(ns, REPETITIONS));
+		fflush(stdout);
+	}
+
+	free(sorted);
+	free(tokens);
+	free(versions);
+	free(token_storage);
+	free(storage);
+	return 0;
+}
+
+int bench_versions(int argc, char **argv) {
+	size_t default_counts[] = { 10000, 100000, 1000000 };
+	size_t *counts = default_counts;
+	size_t count_num = sizeof(default_counts) / sizeof(default_counts[0]);
+
+	if(argc > 0) {
+		counts = malloc(argc * sizeof(size_t));
+		if(counts == NULL) return 1;
+
+		for(int i = 0; i < argc; ++i) counts[i] = strtoul(argv[i], NULL, 10);
+		count_num = argc;
+	}
+
+	printf("# versions: median ns per version string, sorted with qsort()\n");
+	printf("%10s  %-10s %14s %14s\n", "versions", "comparator", "prepare", "sort");
+
+	int result = 0;
+	for(size_t c = 0; (c < count_num) && (result == 0); ++c) result = run_config(counts[c]);
+
+	if(counts != default_counts) free(counts);
+	return (result == 0) ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/aggregate.h"
+#include "src/buffers.h"
+#include "src/hashmap.h"
+#include "src/lang.h"
+#include "src/snapshot.h"
+
+#define MAX_THREADS 16
+
+// Hosts are grouped into buckets of 10% non-free packages; the last bucket is for exactly 100%.
+#define RATIO_BUCKETS 11
+
+// Attached to every hash map entry. "last_host" makes sure a host is counted only once
+// when it has several packages with the same name (e.g. multilib) or licence.
+struct Counter {
+	size_t last_host;
+	size_t hosts;
+	size_t packages;
+	size_t nonfree_packages;
+};
+
+struct AggregateTask {
+	char *const *paths;
+	size_t first, count, step;
+
+	struct HashMap *nonfree; // Package name -> counter
+	struct HashMap *licences; // Licence -> counter
+	struct ChainBuffer *strings; // Storage for the hash map keys and counters
+
+	size_t hosts, failed, packages, nonfree_packages;
+	size_t ratio[RATIO_BUCKETS];
+	int error;
+};
+
+static struct Counter* count_key(struct AggregateTask *task, struct HashMap *map, const char *key, size_t host, int is_free) {
+	struct HashMapEntry *entry = hashmap_find(map, key);
+	if(entry == NULL) {
+		const char *copy = chainbuf_append(&task->strings, key);
+		if(copy == NULL) return NULL;
+
+		entry = hashmap_insert(map, copy);
+		if(entry == NULL) return NULL;
+
+		const struct Counter empty = { .last_host = (size_t)-1 };
+		entry->data = chainbuf_appendAligned(&task->strings, &empty, sizeof(empty));
+		if(entry->data == NULL) return NULL;
+	}
+
+	struct Counter *counter = entry->data;
+	if(counter->last_host != host) {
+		counter->last_host = host;
+		counter->hosts += 1;
+	}
+	counter->packages += 1;
+	if(!is_free) counter->nonfree_packages += 1;
+	return counter;
+}
+
+static int process_snapshot(struct AggregateTask *task, size_t host) {
+	struct Snapshot *snapshot = snapshot_read(task->paths[host], 0);
+	if(snapshot == NULL) {
+		lang_fprint(stderr, MSG_ERR_SNAPSHOT_READ_FAILED, task->paths[host]);
+		task->failed += 1;
+		return 0;
+	}
+
+	size_t nonfree = 0;
+	for(size_t i = 0; i < snapshot->count; ++i) {
+		const struct SnapshotEntry *entry = &snapshot->entries[i];
+		if(count_key(task, task->licences, entry->licence, host, entry->is_free) == NULL) goto fail;
+		if(entry->is_free) continue;
+
+		if(count_key(task, task->nonfree, entry->name, host, 0) == NULL) goto fail;
+		++nonfree;
+	}
+
+	// Same math as in packages_list(), so the numbers match what the hosts report.
+	const size_t total = snapshot->count;
+	const long promil_nonfree = (total > 0) ? (1000L * nonfree) / total : 0;
+	task->ratio[promil_nonfree / 100] += 1;
+
+	task->hosts += 1;
+	task->packages += total;
+	task->nonfree_packages += nonfree;
+	snapshot_free(snapshot);
+	return 0;
+
+	fail: { // As seen in CVE-2014-1266!
+		snapshot_free(snapshot);
+		return -1;
+	}
+}
+
+static void* aggregate_task(void *arg) {
+	struct AggregateTask *task = arg;
+	for(size_t host = task->first; host < task->count; host += task->step) {
+		if(process_snapshot(task, host) != 0) {
+			task->error = 1;
+			break;
+		}
+	}
+	return NULL;
+}
+
+// Add the counters from one of the per-thread maps into another.
+static int merge_map(struct HashMap *dst, const struct HashMap *src) {
+	for(size_t i = 0; i < src->capacity; ++i) {
+		const struct HashMapEntry *entry = &src->entries[i];
+		if(entry->key == NULL) continue;
+
+		// Keys and counters of the source map stay alive until all tasks are freed,
+		// so new entries can simply point to them.
+		struct HashMapEntry *target = hashmap_insert(dst, entry->key);
+		if(target == NULL) return -1;
+
+		if(target->data == NULL) {
+			target->data = entry->data;
+		} else {
+			struct Counter *a = target->data;
+			const struct Counter *b = entry->data;
+			a->hosts += b->hosts;
+			a->packages += b->packages;
+			a->nonfree_packages += b->nonfree_packages;
+		}
+	}
+	return 0;
+}
+
+static int compare_by_hosts(const void *A, const void *B) {
+	const struct HashMapEntry *a = *(const struct HashMapEntry *const*)A;
+	const struct HashMapEntry *b = *(const struct HashMapEntry *const*)B;
+	const struct Counter *ca = a->data;
+	const struct Counter *cb = b->data;
+
+	if(ca->hosts != cb->hosts) return (ca->hosts < cb->hosts) ? +1 : -1;
+	return strcmp(a->key, b->key);
+}
+
+// Returns a sorted array of pointers to the map's entries, or NULL on failure.
+static const struct HashMapEntry** sorted_entries(const struct HashMap *map) {
+	const struct HashMapEntry **list = malloc((map->used > 0 ? map->used : 1) * sizeof(struct HashMapEntry*));
+	if(list == NULL) return NULL;
+
+	size_t n = 0;
+	for(size_t i = 0; i < map->capacity; ++i) {
+		if(map->entries[i].key != NULL) list[n++] = &map->entries[i];
+	}
+	qsort(list, n, sizeof(struct HashMapEntry*), &compare_by_hosts);
+	return list;
+}
+
+static int print_results(const struct AggregateTask *total) {
+	const struct HashMapEntry **nonfree = sorted_entries(total->nonfree);
+	const struct HashMapEntry **licences = sorted_entries(total->licences);
+	if((nonfree == NULL) || (licences == NULL)) {
+		free(nonfree);
+		free(licences);
+		return -1;
+	}
+
+	printf("%-40s %12zu\n", "hosts", total->hosts);
+	printf("%-40s %12zu\n", "hosts_failed", total->failed);
+	printf("%-40s %12zu\n", "packages", total->packages);
+	printf("%-40s %12zu\n", "nonfree_packages", total->nonfree_packages);
+
+	printf("\n%-40s %12s\n", "nonfree_ratio", "hosts");
+	for(int b = 0; b < RATIO_BUCKETS; ++b) {
+		char range[32];
+		if(b < RATIO_BUCKETS - 1)
+			snprintf(range, sizeof(range), "%d.0%% - %d.9%%", b * 10, b * 10 + 9);
+		else
+			snprintf(range, sizeof(range), "100.0%%");
+		printf("%-40s %12zu\n", range, total->ratio[b]);
+	}
+
+	printf("\n%-40s %12s\n", "nonfree_package", "hosts");
+	for(size_t i = 0; i < total->nonfree->used; ++i) {
+		const struct Counter *c = nonfree[i]->data;
+		printf("%-40s %12zu\n", nonfree[i]->key, c->hosts);
+	}
+
+	printf("\n%-40s %12s %12s %12s\n", "licence", "hosts", "packages", "nonfree");
+	for(size_t i = 0; i < total->licences->used; ++i) {
+		const struct Counter *c = licences[i]->data;
+		printf("%-40s %12zu %12zu %12zu\n", licences[i]->key, c->hosts, c->packages, c->nonfree_packages);
+	}
+
+	free(nonfree);
+	free(licences);
+	return 0;
+}
+
+static int init_task(struct AggregateTask *task, char *const *paths, size_t count, size_t first, size_t step) {
+	*task = (struct AggregateTask){
+		.paths = paths,
+		.first = first,
+		.count = count,
+		.step = step,
+	};
+	task->nonfree = hashmap_init(0, 0);
+	task->licences = hashmap_init(0, 0);
+	task->strings = chainbuf_init(16256);
+	return ((task->nonfree != NULL) && (task->licences != NULL) && (task->strings != NULL)) ? 0 : -1;
+}
+
+static void free_task(struct AggregateTask *task) {
+	hashmap_free(task->nonfree);
+	hashmap_free(task->licences);
+	if(task->strings != NULL) chainbuf_free(task->strings);
+}
+
+int aggregate_snapshots(char *const *paths, size_t count, unsigned int threads) {
+	if(threads > MAX_THREADS) threads = MAX_THREADS;
+	if(threads > count) threads = count;
+	if(threads < 1) threads = 1;
+
+	// Each thread takes every n-th snapshot and collects the results in its own maps,
+	// so there's no need for any locking. The maps are merged once all threads finish.
+	struct AggregateTask tasks[MAX_THREADS];
+	unsigned int initialised = 0;
+	int result = -1;
+	for(; initialised < threads; ++initialised) {
+		if(init_task(&tasks[initialised], paths, count, initialised, threads) != 0) {
+			free_task(&tasks[initialised]);
+			goto end;
+		}
+	}
+
+	// The workers may need to report errors. Load the translations now,
+	// so that happens before there are any other threads around.
+	if(threads > 1) lang_init();
+
+	pthread_t thread[MAX_THREADS];
+	int started[MAX_THREADS];
+	for(unsigned int t = 1; t < threads; ++t) {
+		started[t] = (pthread_create(&thread[t], NULL, &aggregate_task, &tasks[t]) == 0);
+		if(!started[t]) aggregate_task(&tasks[t]);
+	}
+	aggregate_task(&tasks[0]);
+	for(unsigned int t = 1; t < threads; ++t) {
+		if(started[t]) pthread_join(thread[t], NULL);
+	}
+
+	struct AggregateTask *total = &tasks[0];
+	for(unsigned int t = 0; t < threads; ++t) {
+		if(tasks[t].error) goto end;
+		if(t == 0) continue;
+
+		if(merge_map(total->nonfree, tasks[t].nonfree) != 0) goto end;
+		if(merge_map(total->licences, tasks[t].licences) != 0) goto end;
+
+		total->hosts += tasks[t].hosts;
+		total->failed += tasks[t].failed;
+		total->packages += tasks[t].packages;
+		total->nonfree_packages += tasks[t].nonfree_packages;
+		for(int b = 0; b < RATIO_BUCKETS; ++b) total->ratio[b] += tasks[t].ratio[b];
+	}
+
+	if(print_results(total) == 0) result = (int)total->failed;
+
+	end:
+	for(unsigned int t = 0; t < initialised; ++t) free_task(&tasks[t]);
+	return result;
+}
+
+int aggregate_snapshotList(FILE *list, unsigned int threads) {
+	struct ReBuffer *paths = rebuf_init(1024 * sizeof(char*));
+	struct ChainBuffer *strings = chainbuf_init(16256);
+	int result = -1;
+	if((paths == NULL) || (strings == NULL)) goto end;
+
+	char line[4096];
+	while(fgets(line, sizeof(line), list) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if(line[0] == '\0') continue;
+
+		char *path = chainbuf_append(&strings, line);
+		if((path == NULL) || (rebuf_append(paths, &path, sizeof(char*)) == NULL)) goto end;
+	}
+	result = aggregate_snapshots(paths->data, paths->used / sizeof(char*), threads);
+
+	end:
+	if(paths != NULL) rebuf_free(paths);
+	if(strings != NULL) chainbuf_free(strings);
+	return result;
+}
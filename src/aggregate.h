@@ -0,0 +1,37 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_AGGREGATE_H
+#define VRMS_RPM_AGGREGATE_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * Read many snapshots (one per host, as created by --save-snapshot)
+ * and print fleet-wide statistics: how the share of non-free packages
+ * is distributed across hosts, which non-free packages are installed
+ * and on how many hosts, and how many hosts use each licence.
+ *
+ * Snapshots are read in parallel, using the given number of threads.
+ * Returns the number of snapshots that could not be read, or -1 on error.
+ */
+extern int aggregate_snapshots(char *const *paths, size_t count, unsigned int threads);
+
+// Same as above, but read the list of paths from a file, one per line.
+extern int aggregate_snapshotList(FILE *list, unsigned int threads);
+
+#endif
@@ -1,5 +1,5 @@
 # bash-completion file for vrms-rpm
-# Copyright (C) 2018, 2020, 2022-2023 suve (a.k.a. Artur Frenszek-Iwicki)
+# Copyright (C) 2018, 2020, 2022-2024 suve (a.k.a. Artur Frenszek-Iwicki)
 #
 # This program is free software: you can redistribute it and/or modify
 # it under the terms of the GNU General Public License, version 3,
@@ -18,7 +18,7 @@ _vrms_rpm() {
 
 	local curr="${COMP_WORDS[COMP_CWORD]}"
 	local prev="${COMP_WORDS[COMP_CWORD-1]}"
-	local opts="--ascii --colour --describe --evra --explain --grammar --help --image --licence-list --list --version"
+	local opts="--aggregate --ascii --colour --describe --diff-against --evra --explain --fail-on-nonfree --grammar --help --image --licence-list --list --repodata --rpmdb --rpm-timeout --save-snapshot --stats --summary-by-licence --unsorted --version"
 
 	if [[ "$prev" == "--color" ]] || [[ "$prev" == "--colour" ]] || [[ "$prev" == "--evra" ]]; then
 		local when="auto always never"
@@ -35,6 +35,8 @@ _vrms_rpm() {
 			local licences="__LICENCE_LIST__"
 			COMPREPLY=( $(compgen -W "$licences \~ . .. /" -- "$curr") )
 		fi
+	elif [[ "$prev" == "--repodata" ]] || [[ "$prev" == "--rpmdb" ]] || [[ "$prev" == "--diff-against" ]] || [[ "$prev" == "--save-snapshot" ]]; then
+		COMPREPLY=( $(compgen -f -- "$curr") )
 	elif [[ "$prev" == "--list" ]]; then
 		local listmodes="none free non-free all"
 		COMPREPLY=( $(compgen -W "$listmodes" -- "$curr") )
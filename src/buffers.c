@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2021, 2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2021, 2023-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -14,10 +14,13 @@
  * You should have received a copy of the GNU General Public License along with
  * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
  */
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "src/buffers.h"
+#include "src/stats.h"
 
 struct ChainBuffer* chainbuf_init(size_t capacity) {
 	if(capacity == 0) return NULL;
@@ -28,6 +31,7 @@ struct ChainBuffer* chainbuf_init(size_t capacity) {
 		buf->capacity = capacity;
 		buf->used = 0;
 		buf->previous = NULL;
+		stats_chainbufAlloc(capacity);
 	}
 
 	return buf;
@@ -37,12 +41,16 @@ void chainbuf_free(struct ChainBuffer *buf) {
 	while(buf != NULL) {
 		struct ChainBuffer *current = buf;
 		buf = buf->previous;
+		stats_chainbufFree(current->capacity);
 		free(current);
 	}
 }
 
 char* chainbuf_append(struct ChainBuffer **buf, const char *data) {
-	const size_t dataLength = strlen(data) + 1;
+	return chainbuf_appendData(buf, data, strlen(data) + 1);
+}
+
+void* chainbuf_appendData(struct ChainBuffer **buf, const void *data, const size_t dataLength) {
 	const size_t remaining = (*buf)->capacity - (*buf)->used;
 
 	if(dataLength > remaining) {
@@ -108,3 +116,27 @@ void* rebuf_append(struct ReBuffer *const buf, const void *const data, const siz
 	
 	return (void*)insert_pos;
 }
+
+// Number of padding bytes needed to align the next insert position for any type.
+static size_t align_padding(const struct ChainBuffer *buf) {
+	const uintptr_t pos = (uintptr_t)(buf->data + buf->used);
+	return (_Alignof(max_align_t) - (pos % _Alignof(max_align_t))) % _Alignof(max_align_t);
+}
+
+void* chainbuf_appendAligned(struct ChainBuffer **buf, const void *data, const size_t dataLength) {
+	// Make sure the data fits in a fresh buffer, no matter how much padding it needs.
+	if(dataLength + _Alignof(max_align_t) > (*buf)->capacity) return NULL;
+
+	size_t padding = align_padding(*buf);
+	if(padding + dataLength > (*buf)->capacity - (*buf)->used) {
+		struct ChainBuffer *newbuf = chainbuf_init((*buf)->capacity);
+		if(newbuf == NULL) return NULL;
+
+		newbuf->previous = *buf;
+		*buf = newbuf;
+		padding = align_padding(*buf);
+	}
+
+	(*buf)->used += padding;
+	return chainbuf_appendData(buf, data, dataLength);
+}
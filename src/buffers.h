@@ -39,6 +39,9 @@ extern struct ChainBuffer* chainbuf_init(size_t capacity);
 extern void chainbuf_free(struct ChainBuffer *buf);
 
 extern char* chainbuf_append(struct ChainBuffer **buf, const char *data);
+extern void* chainbuf_appendData(struct ChainBuffer **buf, const void *data, size_t dataLength);
+// Same as above, but the data is placed at an address suitably aligned for any type.
+extern void* chainbuf_appendAligned(struct ChainBuffer **buf, const void *data, size_t dataLength);
 
 extern struct ReBuffer* rebuf_init(size_t stepSize);
 extern void rebuf_free(struct ReBuffer *buf);
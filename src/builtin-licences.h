@@ -0,0 +1,2616 @@
+/**
+ * This file has been auto-generated by generate-builtin-licences.sh on 2026-10-19, 09:35:43.
+ * Any changes you make here will probably be overwritten by the build system.
+ */
+#ifndef VRMS_RPM_BUILTIN_LICENCES_H
+#define VRMS_RPM_BUILTIN_LICENCES_H
+
+#define BUILTIN_LICENCE_LIST  "tweaked"
+
+#define BUILTIN_LICENCE_COUNT    940
+#define BUILTIN_LICENCE_BUCKETS  471
+#define BUILTIN_LICENCE_SLOTS    1181
+#define BUILTIN_LICENCE_NO_SLOT  0xFFFF
+
+static const char *const builtin_licence_names[BUILTIN_LICENCE_COUNT] = {
+	"0bsd",
+	"aal",
+	"abstyles",
+	"adacore-doc",
+	"adobe",
+	"adobe-2006",
+	"adobe-glyph",
+	"adsl",
+	"afl",
+	"afl-1.1",
+	"afl-1.2",
+	"afl-2.0",
+	"afl-2.1",
+	"afl-3.0",
+	"afmparse",
+	"agpl",
+	"agpl-1.0",
+	"agpl-1.0-only",
+	"agpl-3.0",
+	"agpl-3.0+",
+	"agpl-3.0-only",
+	"agpl-3.0-or-later",
+	"agplv1",
+	"agplv3",
+	"agplv3+",
+	"ahfl",
+	"amdplpa",
+	"aml",
+	"ampas",
+	"ampas bsd",
+	"ams",
+	"antlr-pd",
+	"apache software license 2.0",
+	"apache-1.0",
+	"apache-1.1",
+	"apache-2.0",
+	"apache-2.0 with llvm-exception",
+	"apache-2.0 with swift-exception",
+	"apache-2.0+",
+	"apafml",
+	"apl-1.0",
+	"app-s2p",
+	"apsl 2.0",
+	"apsl-1.0",
+	"apsl-1.1",
+	"apsl-1.2",
+	"apsl-2.0",
+	"arl",
+	"arphic",
+	"arphic-1999",
+	"array",
+	"artistic",
+	"artistic 1.0",
+	"artistic 2.0",
+	"artistic clarified",
+	"artistic licence 1.0",
+	"artistic licence 2.0",
+	"artistic-1.0",
+	"artistic-1.0+",
+	"artistic-1.0-cl8",
+	"artistic-1.0-perl",
+	"artistic-2.0",
+	"asl 1.0",
+	"asl 1.1",
+	"asl 2.0",
+	"asl 2.0 with exceptions for gpl2/lgpl2",
+	"asl1.0",
+	"asl1.1",
+	"asl2",
+	"asl2.0",
+	"aslv2",
+	"aslv2.0",
+	"aslv2.0+",
+	"baekmuk",
+	"bahyph",
+	"barr",
+	"beerware",
+	"beopen",
+	"bibtex",
+	"bitstream vera",
+	"bitstream vera fonts copyright",
+	"bitstream-charter",
+	"bitstream-vera",
+	"bittorrent",
+	"bittorrent-1.1",
+	"blessing",
+	"blueoak-1.0.0",
+	"boehm-gc",
+	"boost",
+	"boost-1.0",
+	"borceux",
+	"brian-gladman-3-clause",
+	"bsd",
+	"bsd 2-clause",
+	"bsd 3-clause",
+	"bsd 4-clause",
+	"bsd protection",
+	"bsd-1-clause",
+	"bsd-2-clause",
+	"bsd-2-clause-freebsd",
+	"bsd-2-clause-netbsd",
+	"bsd-2-clause-patent",
+	"bsd-2-clause-views",
+	"bsd-2c",
+	"bsd-3",
+	"bsd-3-clause",
+	"bsd-3-clause-attribution",
+	"bsd-3-clause-clear",
+	"bsd-3-clause-lbnl",
+	"bsd-3-clause-modification",
+	"bsd-3-clause-open-mpi",
+	"bsd-4-clause",
+	"bsd-4-clause-uc",
+	"bsd-4.3tahoe",
+	"bsd-advertising-acknowledgement",
+	"bsd-mark-modifications",
+	"bsd-protection",
+	"bsd-source-code",
+	"bsd2c",
+	"bsd3",
+	"bsd3c",
+	"bsd4c",
+	"bsl-1.0",
+	"bzip2-1.0.6",
+	"cal-1.0",
+	"cal-1.0-combined-work-exception",
+	"catosl",
+	"catosl-1.1",
+	"cc-by",
+	"cc-by-1.0",
+	"cc-by-2.0",
+	"cc-by-2.5",
+	"cc-by-2.5-au",
+	"cc-by-3.0",
+	"cc-by-3.0-at",
+	"cc-by-3.0-de",
+	"cc-by-3.0-nl",
+	"cc-by-3.0-us",
+	"cc-by-4.0",
+	"cc-by-nd",
+	"cc-by-nd-1.0",
+	"cc-by-nd-2.0",
+	"cc-by-nd-2.5",
+	"cc-by-nd-3.0",
+	"cc-by-nd-3.0-de",
+	"cc-by-nd-4.0",
+	"cc-by-sa",
+	"cc-by-sa-1.0",
+	"cc-by-sa-2.0",
+	"cc-by-sa-2.0-uk",
+	"cc-by-sa-2.1-jp",
+	"cc-by-sa-2.5",
+	"cc-by-sa-3.0",
+	"cc-by-sa-3.0-at",
+	"cc-by-sa-3.0-de",
+	"cc-by-sa-4.0",
+	"cc-by-sav1",
+	"cc-by-sav1+",
+	"cc-by-sav2",
+	"cc-by-sav2+",
+	"cc-by-sav3",
+	"cc-by-sav3+",
+	"cc-by-sav4",
+	"cc-by-sav4+",
+	"cc-pddc",
+	"cc0",
+	"cc0-1.0",
+	"cc0-2.0",
+	"cc0-3.0",
+	"cc0-4.0",
+	"cddl",
+	"cddl 1.0",
+	"cddl 1.1",
+	"cddl-1.0",
+	"cddl-1.1",
+	"cdl",
+	"cecill",
+	"cecill-1.1",
+	"cecill-2.0",
+	"cecill-2.1",
+	"cecill-b",
+	"cecill-c",
+	"cern-ohl-p-2.0",
+	"cern-ohl-s-2.0",
+	"cern-ohl-w-2.0",
+	"cfitsio",
+	"charter",
+	"check-cvs",
+	"checkmk",
+	"clartistic",
+	"cmu-mach",
+	"cnri",
+	"cnri-python",
+	"condor",
+	"condor-1.1",
+	"copyright only",
+	"cpal",
+	"cpal-1.0",
+	"cpl",
+	"cpl-1.0",
+	"cpm",
+	"crc32",
+	"crossword",
+	"crystal stacker",
+	"crystalstacker",
+	"cua-opl-1.0",
+	"cube",
+	"curl",
+	"diffmark",
+	"dl-de-by",
+	"dl-de-by-2.0",
+	"dmit",
+	"dmtf",
+	"doc",
+	"dotseqn",
+	"doublestroke",
+	"dsdp",
+	"dsl",
+	"dtoa",
+	"dvipdfm",
+	"dwpl",
+	"ec",
+	"ecl 1.0",
+	"ecl 2.0",
+	"ecl-1.0",
+	"ecl-2.0",
+	"eclipse-1.0",
+	"ecos",
+	"ecos-2.0",
+	"efl 2.0",
+	"efl-1.0",
+	"efl-2.0",
+	"efml",
+	"egenix",
+	"elvish",
+	"entessa",
+	"epics",
+	"epl",
+	"epl 1.0",
+	"epl 1.1",
+	"epl 2.0",
+	"epl-1",
+	"epl-1.0",
+	"epl-1.1",
+	"epl-2.0",
+	"erlpl-1.1",
+	"erpl",
+	"etalab-2.0",
+	"eu datagrid",
+	"eudatagrid",
+	"eupl 1.1",
+	"eupl 1.2",
+	"eupl-1.1",
+	"eupl-1.2",
+	"eurosym",
+	"expat",
+	"fair",
+	"fbsddl",
+	"fdk-aac",
+	"fdl-1.2+",
+	"fdl-1.3+",
+	"fdlv1.2+",
+	"fltk",
+	"frameworx-1.0",
+	"free art",
+	"freebsd-doc",
+	"freeimage",
+	"freely distributable",
+	"freely redistributable without restriction",
+	"freetype",
+	"fsfap",
+	"fsful",
+	"fsfullr",
+	"fsfullrwd",
+	"ftl",
+	"geogratis",
+	"gfdl",
+	"gfdl+",
+	"gfdl-1.1",
+	"gfdl-1.1+",
+	"gfdl-1.1-invariants-only",
+	"gfdl-1.1-invariants-or-later",
+	"gfdl-1.1-no-invariants-only",
+	"gfdl-1.1-no-invariants-or-later",
+	"gfdl-1.1-only",
+	"gfdl-1.1-or-later",
+	"gfdl-1.2",
+	"gfdl-1.2+",
+	"gfdl-1.2-invariants-only",
+	"gfdl-1.2-invariants-or-later",
+	"gfdl-1.2-no-invariants-only",
+	"gfdl-1.2-no-invariants-or-later",
+	"gfdl-1.2-only",
+	"gfdl-1.2-or-later",
+	"gfdl-1.3",
+	"gfdl-1.3+",
+	"gfdl-1.3-invariants-only",
+	"gfdl-1.3-invariants-or-later",
+	"gfdl-1.3-no-invariants-or-later",
+	"gfdl-1.3-only",
+	"gfdl-1.3-or-later",
+	"gfdlv1.1",
+	"gfdlv1.1+",
+	"gfdlv1.2",
+	"gfdlv1.2+",
+	"gfdlv1.3",
+	"gfdlv1.3+",
+	"gfsl",
+	"giftware",
+	"gl2ps",
+	"glide",
+	"glpv2",
+	"glulxe",
+	"gnu lesser general public license v3.0 only",
+	"gnu lesser general public license v3.0 only, with exceptions",
+	"gnuplot",
+	"gpl",
+	"gpl 1",
+	"gpl 1+",
+	"gpl 2",
+	"gpl 2+",
+	"gpl 3",
+	"gpl 3+",
+	"gpl v1",
+	"gpl v1+",
+	"gpl v2",
+	"gpl v2+",
+	"gpl v3",
+	"gpl v3+",
+	"gpl+",
+	"gpl+ or artistic",
+	"gpl-1.0",
+	"gpl-1.0+",
+	"gpl-1.0-only",
+	"gpl-1.0-or-later",
+	"gpl-1.0-or-later or artistic-1.0-perl",
+	"gpl-1.0-or-later with linux-syscall-note",
+	"gpl-2",
+	"gpl-2+",
+	"gpl-2.0",
+	"gpl-2.0+",
+	"gpl-2.0-only",
+	"gpl-2.0-only with 389-exception",
+	"gpl-2.0-only with asterisk-exception",
+	"gpl-2.0-only with classpath-exception-2.0",
+	"gpl-2.0-only with font-exception-2.0",
+	"gpl-2.0-only with gcc-exception-2.0",
+	"gpl-2.0-only with libpri-openh323-exception",
+	"gpl-2.0-only with linux-syscall-note",
+	"gpl-2.0-or-later",
+	"gpl-2.0-or-later or artistic-1.0-perl",
+	"gpl-2.0-or-later with autoconf-exception-generic",
+	"gpl-2.0-or-later with bison-exception-2.2",
+	"gpl-2.0-or-later with classpath-exception-2.0",
+	"gpl-2.0-or-later with cryptsetup-openssl-exception",
+	"gpl-2.0-or-later with ecos-2.0",
+	"gpl-2.0-or-later with ecos-exception-2.0",
+	"gpl-2.0-or-later with font-exception-2.0",
+	"gpl-2.0-or-later with gcc-exception-2.0",
+	"gpl-2.0-or-later with gnat-exception",
+	"gpl-2.0-or-later with libtool-exception",
+	"gpl-2.0-or-later with linux-syscall-note",
+	"gpl-2.0-or-later with swi-exception",
+	"gpl-2.0-or-later with wxwindows-exception-3.1",
+	"gpl-2.0-or-later with x11vnc-openssl-exception",
+	"gpl-2.0-with-floss-exception",
+	"gpl-3",
+	"gpl-3+",
+	"gpl-3.0",
+	"gpl-3.0+",
+	"gpl-3.0-only",
+	"gpl-3.0-only with classpath-exception-2.0",
+	"gpl-3.0-only with font-exception-2.0",
+	"gpl-3.0-only with gcc-exception-3.1",
+	"gpl-3.0-only with gpl-3.0-interface-exception",
+	"gpl-3.0-only with qt-gpl-exception-1.0",
+	"gpl-3.0-or-later",
+	"gpl-3.0-or-later with autoconf-exception-3.0",
+	"gpl-3.0-or-later with autoconf-exception-generic-3.0",
+	"gpl-3.0-or-later with autoconf-exception-macro",
+	"gpl-3.0-or-later with bison-exception-2.2",
+	"gpl-3.0-or-later with classpath-exception-2.0",
+	"gpl-3.0-or-later with cryptsetup-openssl-exception",
+	"gpl-3.0-or-later with font-exception-2.0",
+	"gpl-3.0-or-later with gcc-exception-3.1",
+	"gpl-3.0-or-later with gnat-exception",
+	"gpl-3.0-or-later with gpl-3.0-interface-exception",
+	"gpl-3.0-or-later with texinfo-exception",
+	"gpl-3.0-with-qt-company-qt-exception-1.1",
+	"gpl1",
+	"gpl1.0",
+	"gpl2",
+	"gpl2+",
+	"gpl2.0",
+	"gpl3",
+	"gpl3.0",
+	"gplv1",
+	"gplv1+",
+	"gplv2",
+	"gplv2+",
+	"gplv3",
+	"gplv3+",
+	"green openmusic",
+	"haskellreport",
+	"hershey",
+	"hofl",
+	"hp-1986",
+	"hp-1989",
+	"hpnd",
+	"hpnd-export-us",
+	"hpnd-markus-kuhn",
+	"hpnd-sell-variant",
+	"hpnd-sell-variant-mit-disclaimer",
+	"hsrl",
+	"ibm",
+	"icu",
+	"ieee",
+	"ijg",
+	"ijg-short",
+	"imagemagick",
+	"imatix",
+	"imlib2",
+	"info-zip",
+	"inner-net",
+	"inner-net-2.0",
+	"intel",
+	"intel acpi",
+	"intel-acpi",
+	"interbase",
+	"interbase-1.0",
+	"ipa",
+	"ipl-1.0",
+	"isc",
+	"jabber",
+	"jam",
+	"jasper",
+	"jasper-2.0",
+	"jpl-image",
+	"jpython",
+	"json",
+	"julius",
+	"kazlib",
+	"knuth",
+	"knuth-ctan",
+	"lal-1.2",
+	"lal-1.3",
+	"latex2e",
+	"latex2e-translated-notice",
+	"lbnl bsd",
+	"ldpl",
+	"leptonica",
+	"lgpl",
+	"lgpl+",
+	"lgpl-1.0",
+	"lgpl-1.0+",
+	"lgpl-2.0",
+	"lgpl-2.0+",
+	"lgpl-2.0-only",
+	"lgpl-2.0-only with ocaml-lgpl-linking-exception",
+	"lgpl-2.0-or-later",
+	"lgpl-2.0-or-later with fltk-exception",
+	"lgpl-2.0-or-later with gcc-exception-2.0",
+	"lgpl-2.0-or-later with linux-syscall-note",
+	"lgpl-2.0-or-later with ocaml-lgpl-linking-exception",
+	"lgpl-2.0-or-later with wxwindows-exception-3.1",
+	"lgpl-2.1",
+	"lgpl-2.1+",
+	"lgpl-2.1-only",
+	"lgpl-2.1-only with ocaml-lgpl-linking-exception",
+	"lgpl-2.1-or-later",
+	"lgpl-2.1-or-later with cryptsetup-openssl-exception",
+	"lgpl-2.1-or-later with gcc-exception-2.0",
+	"lgpl-2.1-or-later with linux-syscall-note",
+	"lgpl-2.1-or-later with ocaml-lgpl-linking-exception",
+	"lgpl-2.1-or-later with qwt-exception-1.0",
+	"lgpl-2.1-with-qt-company-qt-exception-1.1",
+	"lgpl-3.0",
+	"lgpl-3.0+",
+	"lgpl-3.0-only",
+	"lgpl-3.0-only with lgpl-3.0-linking-exception",
+	"lgpl-3.0-only with ocaml-lgpl-linking-exception",
+	"lgpl-3.0-only with openvpn-openssl-exception",
+	"lgpl-3.0-or-later",
+	"lgpl-3.0-or-later with ocaml-lgpl-linking-exception",
+	"lgpl-3.0-with-qt-company-qt-exception-1.1",
+	"lgpl2.1",
+	"lgplv2",
+	"lgplv2+",
+	"lgplv2.0",
+	"lgplv2.0+",
+	"lgplv2.1",
+	"lgplv2.1+",
+	"lgplv3",
+	"lgplv3+",
+	"lhcyr",
+	"liberation",
+	"libtiff",
+	"libutil-david-nugent",
+	"licenseref-ahfl",
+	"licenseref-ams",
+	"licenseref-array",
+	"licenseref-bacula",
+	"licenseref-beopen",
+	"licenseref-bibtex",
+	"licenseref-cclp1",
+	"licenseref-cclp2",
+	"licenseref-cdl",
+	"licenseref-charter",
+	"licenseref-cpm",
+	"licenseref-crc32",
+	"licenseref-dmit",
+	"licenseref-dmtf",
+	"licenseref-doublestroke",
+	"licenseref-dsl",
+	"licenseref-ec",
+	"licenseref-efml",
+	"licenseref-elvish",
+	"licenseref-fedora-public-domain",
+	"licenseref-fedora-ultrapermissive",
+	"licenseref-geogratis",
+	"licenseref-hershey",
+	"licenseref-hofl",
+	"licenseref-ieee",
+	"licenseref-jabber",
+	"licenseref-jpython",
+	"licenseref-ldpl",
+	"licenseref-lhcyr",
+	"licenseref-liberation",
+	"licenseref-libzmq",
+	"licenseref-license-of-licenses",
+	"licenseref-logica",
+	"licenseref-losla",
+	"licenseref-lppl",
+	"licenseref-lucida",
+	"licenseref-mgopen",
+	"licenseref-midnight",
+	"licenseref-mod_macro",
+	"licenseref-newmat",
+	"licenseref-oal",
+	"licenseref-ofsfdl",
+	"licenseref-opendata",
+	"licenseref-openmusic-green",
+	"licenseref-par",
+	"licenseref-plaintex",
+	"licenseref-ptfl",
+	"licenseref-public-use",
+	"licenseref-punknova",
+	"licenseref-radvd",
+	"licenseref-rex",
+	"licenseref-ricebsd",
+	"licenseref-romio",
+	"licenseref-rsa",
+	"licenseref-rsfs",
+	"licenseref-scrip",
+	"licenseref-slib",
+	"licenseref-softsurfer",
+	"licenseref-stix",
+	"licenseref-stmpl",
+	"licenseref-tgppl",
+	"licenseref-threeparttable",
+	"licenseref-tolua",
+	"licenseref-utopia",
+	"licenseref-vnlsl",
+	"licenseref-wadalab",
+	"licenseref-xano",
+	"licenseref-zplv1.0",
+	"liliq-p-1.1",
+	"liliq-r-1.1",
+	"liliq-rplus-1.1",
+	"linux-man-pages-1-para",
+	"linux-man-pages-copyleft",
+	"linux-man-pages-copyleft-2-para",
+	"linux-man-pages-copyleft-var",
+	"linux-openib",
+	"llgpl",
+	"logica",
+	"loop",
+	"losla",
+	"lpl",
+	"lpl-1.0",
+	"lpl-1.02",
+	"lppl",
+	"lppl 1.2",
+	"lppl 1.3",
+	"lppl-1.2",
+	"lppl-1.3a",
+	"lppl-1.3c",
+	"lucida",
+	"makeindex",
+	"martin-birgmeier",
+	"mecab-ipadic",
+	"metamail",
+	"mgopen",
+	"midnight",
+	"minpack",
+	"miros",
+	"mit",
+	"mit license",
+	"mit-0",
+	"mit-advertising",
+	"mit-cmu",
+	"mit-enna",
+	"mit-feh",
+	"mit-festival",
+	"mit-licence",
+	"mit-modern-variant",
+	"mit-open-group",
+	"mit-testregex",
+	"mit-wu",
+	"mit/x11",
+	"mitnfa",
+	"mod_macro",
+	"motosoto",
+	"mpich2",
+	"mpl 1.0",
+	"mpl 1.1",
+	"mpl 2.0",
+	"mpl-1.0",
+	"mpl-1.1",
+	"mpl-1.1+",
+	"mpl-2.0",
+	"mpl-2.0-no-copyleft-exception",
+	"mpl1.0",
+	"mpl1.1",
+	"mpl2.0",
+	"mplus",
+	"mplv1.0",
+	"mplv1.0+",
+	"mplv1.1",
+	"mplv1.1+",
+	"mplv2.0",
+	"mplv2.0+",
+	"ms-pl",
+	"ms-rl",
+	"mtll",
+	"mulanpsl-2.0",
+	"multics",
+	"mup",
+	"naist-2003",
+	"nasa-1.3",
+	"naumen",
+	"ncsa",
+	"netcdf",
+	"netscape",
+	"newmat",
+	"newsletr",
+	"ngpl",
+	"nist-pd",
+	"nist-pd-fallback",
+	"nist-software",
+	"nistsl",
+	"nlpl",
+	"nmap",
+	"nokia",
+	"nonfree",
+	"nosl",
+	"noweb",
+	"npl-1.0",
+	"npl-1.1",
+	"nposl-3.0",
+	"nrl",
+	"ntp",
+	"nunit",
+	"oal",
+	"oasis-specification-notice",
+	"oclc-2.0",
+	"odbl-1.0",
+	"offis",
+	"ofl",
+	"ofl-1.0",
+	"ofl-1.1",
+	"ofl-1.1-no-rfn",
+	"ofl-1.1-rfn",
+	"ofsfdl",
+	"ogl",
+	"ogl-uk-3.0",
+	"ogtsl",
+	"oldap-2.3",
+	"oldap-2.7",
+	"oldap-2.8",
+	"olfl-1.3",
+	"oml",
+	"open publication",
+	"openldap",
+	"openpbs",
+	"openpbs-2.3",
+	"openssl",
+	"opl-1.0",
+	"oreilly",
+	"oset-pl-2.1",
+	"osl 1.0",
+	"osl 1.1",
+	"osl 2.0",
+	"osl 2.1",
+	"osl 3.0",
+	"osl-1.0",
+	"osl-1.1",
+	"osl-2.0",
+	"osl-2.1",
+	"osl-3.0",
+	"ouverte",
+	"par",
+	"pddl-1.0",
+	"perl",
+	"phorum",
+	"php",
+	"php-3.0",
+	"php-3.0.1",
+	"php-3.01",
+	"plaintex",
+	"plexus",
+	"postgresql",
+	"psf",
+	"psf-2.0",
+	"psfrag",
+	"psutils",
+	"ptfl",
+	"public domain",
+	"public use",
+	"punknova",
+	"python",
+	"python-2.0",
+	"python-2.0.1",
+	"qhull",
+	"qpl",
+	"qpl-1.0",
+	"qpl-1.0-inria-2004 with qpl-1.0-inria-2004-exception",
+	"radvd",
+	"rdisc",
+	"rex",
+	"ricebsd",
+	"romio",
+	"rpl-1.1",
+	"rpl-1.5",
+	"rpsl",
+	"rpsl-1.0",
+	"rsa",
+	"rscpl",
+	"rsfs",
+	"ruby",
+	"saxpath",
+	"scea",
+	"scrip",
+	"sendmail",
+	"sendmail-8.23",
+	"sequence",
+	"sgi-b-2.0",
+	"sgp4",
+	"simpl-2.0",
+	"sissl",
+	"sl",
+	"sleepycat",
+	"slib",
+	"smlnj",
+	"snia",
+	"softsurfer",
+	"soundex",
+	"spencer-86",
+	"spencer-94",
+	"spencer-99",
+	"spl",
+	"spl-1.0",
+	"sprintf",
+	"ssh-openssh",
+	"standardml-nj",
+	"stix",
+	"stmpl",
+	"sunpro",
+	"suse-agpl-3.0+",
+	"suse-apache-2.0+",
+	"suse-arphic",
+	"suse-artistic-1.0+",
+	"suse-beerware",
+	"suse-bitstream-vera",
+	"suse-bsd-3-clause-with-non-nuclear-addition",
+	"suse-bsd-mark-modifications",
+	"suse-cacertroot",
+	"suse-cc-sampling-plus-1.0",
+	"suse-copyleft-next-0.3.0",
+	"suse-cpl-0.5",
+	"suse-curb",
+	"suse-dmtf",
+	"suse-docbook-xsl",
+	"suse-egenix-1.1.0",
+	"suse-eula",
+	"suse-fhs",
+	"suse-firmware",
+	"suse-fltk",
+	"suse-free-art-1.3",
+	"suse-freetype",
+	"suse-gfdl-1.1+",
+	"suse-gfdl-1.2+",
+	"suse-gfdl-1.3+",
+	"suse-gitslave",
+	"suse-gl2ps-2.0",
+	"suse-gnuplot",
+	"suse-gpl-2.0+-with-openssl-exception",
+	"suse-gpl-2.0+-with-sane-exception",
+	"suse-gpl-2.0-with-floss-exception",
+	"suse-gpl-2.0-with-linking-exception",
+	"suse-gpl-2.0-with-openssl-exception",
+	"suse-gpl-2.0-with-osi-exception",
+	"suse-gpl-2.0-with-plugin-exception",
+	"suse-gpl-3.0+",
+	"suse-gpl-3.0+-with-font-exception",
+	"suse-gpl-3.0+-with-openssl-exception",
+	"suse-gpl-3.0-with-floss-exception",
+	"suse-gpl-3.0-with-font-exception",
+	"suse-gpl-3.0-with-openssl-exception",
+	"suse-gpl-3.0-with-template-exception",
+	"suse-hack-open-font-2.0",
+	"suse-ibpl-1.0",
+	"suse-idpl-1.0",
+	"suse-ieee",
+	"suse-ijg",
+	"suse-innernet-2.0",
+	"suse-innernet-2.00",
+	"suse-json",
+	"suse-ldpl-2.0",
+	"suse-lgpl-2.0-with-linking-exception",
+	"suse-lgpl-2.1-with-digia-exception-1.1",
+	"suse-lgpl-2.1-with-nokia-exception-1.1",
+	"suse-lgpl-3.0-with-openssl-exception",
+	"suse-liberation",
+	"suse-makeindex",
+	"suse-manpages",
+	"suse-matplotlib",
+	"suse-mgopen",
+	"suse-mirror",
+	"suse-mit-khronos",
+	"suse-mpl-1.1+",
+	"suse-mplus",
+	"suse-netcdf",
+	"suse-oasis-specification-notice",
+	"suse-oldfsfdoclicense",
+	"suse-oml",
+	"suse-openpublication-1.0",
+	"suse-osl-1.1",
+	"suse-permissive",
+	"suse-permissive-modify-by-patch",
+	"suse-php-2.02",
+	"suse-public-domain",
+	"suse-python-1.6",
+	"suse-qhull",
+	"suse-qwt-1.0",
+	"suse-redistributable-content",
+	"suse-repoze",
+	"suse-scrot",
+	"suse-sendmail",
+	"suse-sgi-freeb-2.0",
+	"suse-sip",
+	"suse-slib",
+	"suse-snia-1.0",
+	"suse-snia-1.1",
+	"suse-sun-laboratories",
+	"suse-tcl",
+	"suse-tex",
+	"suse-tgppl-1.0",
+	"suse-ubuntu-font-license-1.0",
+	"suse-vim",
+	"suse-wtfpl-2.0",
+	"suse-wxwidgets-3.1",
+	"suse-xano",
+	"suse-xdebug",
+	"suse-xenonsoft-1.00",
+	"suse-xfree86-1.0",
+	"suse-xinetd",
+	"suse-xsl-lint",
+	"swl",
+	"symlinks",
+	"tcgl",
+	"tcl",
+	"teeworlds",
+	"termreadkey",
+	"tgppl",
+	"threeparttable",
+	"tmate",
+	"tolua",
+	"torque-1.1",
+	"torquev1.1",
+	"tosl",
+	"tpdl",
+	"tpl",
+	"tpl-1.0",
+	"ttwl",
+	"tu-berlin-2.0",
+	"tumbolia",
+	"ucar",
+	"ucd",
+	"ucl-1.0",
+	"unicode",
+	"unicode-dfs-2015",
+	"unicode-dfs-2016",
+	"unixcrypt",
+	"unlicense",
+	"upl",
+	"upl-1.0",
+	"utopia",
+	"verbatim",
+	"vim",
+	"vnlsl",
+	"vostrom",
+	"vsl",
+	"vsl-1.0",
+	"w3c",
+	"w3c-19980720",
+	"wadalab",
+	"watcom-1.0",
+	"webmin",
+	"wsuipa",
+	"wtfpl",
+	"wxwidgets",
+	"wxwindows",
+	"x11",
+	"x11-distribute-modifications-variant",
+	"x11/mit",
+	"xano",
+	"xdebug-1.03",
+	"xerox",
+	"xfig",
+	"xfree86-1.1",
+	"xinetd",
+	"xnet",
+	"xpp",
+	"xskat",
+	"ypl-1.1",
+	"yplv1.1",
+	"zed",
+	"zeeff",
+	"zend",
+	"zend-2.0",
+	"zimbra-1.3",
+	"zlib",
+	"zlib-acknowledgement",
+	"zpl",
+	"zpl-2.0",
+	"zpl-2.1",
+	"zplv1.0",
+	"zplv2.0",
+	"zplv2.1",
+};
+
+static const unsigned short builtin_licence_displacement[BUILTIN_LICENCE_BUCKETS][2] = {
+	{0, 1},
+	{0, 2},
+	{0, 0},
+	{0, 5},
+	{0, 2},
+	{0, 24},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 3},
+	{0, 6},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 5},
+	{0, 0},
+	{0, 3},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 3},
+	{0, 0},
+	{0, 4},
+	{0, 1},
+	{0, 4},
+	{0, 10},
+	{0, 11},
+	{0, 0},
+	{0, 0},
+	{0, 3},
+	{0, 0},
+	{0, 5},
+	{0, 4},
+	{0, 1},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 4},
+	{0, 1},
+	{0, 1},
+	{0, 8},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 2},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 5},
+	{0, 2},
+	{0, 0},
+	{0, 1},
+	{0, 2},
+	{0, 2},
+	{0, 4},
+	{0, 15},
+	{0, 4},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 0},
+	{0, 3},
+	{0, 0},
+	{0, 3},
+	{0, 0},
+	{0, 2},
+	{0, 4},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 23},
+	{0, 11},
+	{0, 0},
+	{0, 3},
+	{0, 6},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 4},
+	{0, 3},
+	{0, 1},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 3},
+	{0, 0},
+	{0, 9},
+	{0, 0},
+	{0, 4},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 1},
+	{0, 1},
+	{0, 2},
+	{0, 0},
+	{0, 1},
+	{0, 1},
+	{0, 0},
+	{0, 1},
+	{0, 10},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 2},
+	{0, 2},
+	{0, 0},
+	{0, 5},
+	{0, 4},
+	{0, 7},
+	{0, 1},
+	{0, 1},
+	{0, 4},
+	{0, 4},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 9},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 2},
+	{0, 1},
+	{0, 3},
+	{0, 1},
+	{0, 0},
+	{0, 2},
+	{0, 1},
+	{0, 10},
+	{0, 2},
+	{0, 1},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 16},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 4},
+	{0, 1},
+	{0, 0},
+	{0, 16},
+	{0, 1},
+	{0, 8},
+	{0, 13},
+	{0, 4},
+	{0, 0},
+	{0, 0},
+	{0, 5},
+	{0, 0},
+	{0, 12},
+	{0, 5},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 3},
+	{0, 0},
+	{0, 0},
+	{0, 4},
+	{0, 0},
+	{0, 5},
+	{0, 3},
+	{0, 6},
+	{0, 1},
+	{0, 0},
+	{0, 2},
+	{0, 11},
+	{0, 4},
+	{0, 2},
+	{0, 2},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 1},
+	{0, 1},
+	{0, 0},
+	{0, 4},
+	{0, 5},
+	{0, 11},
+	{0, 6},
+	{0, 4},
+	{0, 24},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 9},
+	{0, 0},
+	{0, 21},
+	{0, 4},
+	{0, 10},
+	{0, 0},
+	{0, 2},
+	{0, 3},
+	{0, 0},
+	{0, 5},
+	{0, 0},
+	{0, 5},
+	{0, 0},
+	{0, 8},
+	{0, 0},
+	{0, 12},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 3},
+	{0, 0},
+	{0, 0},
+	{0, 24},
+	{0, 3},
+	{0, 1},
+	{0, 3},
+	{0, 0},
+	{0, 8},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 4},
+	{0, 1},
+	{0, 6},
+	{0, 1},
+	{0, 8},
+	{0, 3},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 1},
+	{0, 5},
+	{0, 0},
+	{0, 4},
+	{0, 1},
+	{0, 8},
+	{0, 0},
+	{0, 0},
+	{0, 13},
+	{0, 4},
+	{0, 0},
+	{0, 0},
+	{0, 11},
+	{0, 3},
+	{0, 4},
+	{0, 7},
+	{0, 3},
+	{0, 0},
+	{0, 32},
+	{0, 7},
+	{0, 17},
+	{0, 0},
+	{0, 0},
+	{0, 8},
+	{0, 1},
+	{0, 0},
+	{0, 1},
+	{0, 14},
+	{0, 1},
+	{0, 7},
+	{0, 0},
+	{0, 0},
+	{0, 5},
+	{0, 2},
+	{0, 6},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 35},
+	{0, 1},
+	{0, 9},
+	{0, 18},
+	{0, 5},
+	{0, 9},
+	{0, 43},
+	{0, 4},
+	{0, 27},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 8},
+	{0, 0},
+	{0, 0},
+	{0, 5},
+	{0, 4},
+	{0, 7},
+	{0, 6},
+	{0, 0},
+	{0, 4},
+	{0, 1},
+	{0, 5},
+	{0, 12},
+	{0, 0},
+	{0, 0},
+	{0, 10},
+	{0, 3},
+	{0, 0},
+	{0, 0},
+	{0, 6},
+	{0, 0},
+	{0, 1},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 11},
+	{0, 4},
+	{0, 4},
+	{0, 3},
+	{0, 3},
+	{0, 7},
+	{0, 2},
+	{0, 35},
+	{0, 2},
+	{0, 0},
+	{0, 7},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 10},
+	{0, 1},
+	{0, 0},
+	{0, 0},
+	{0, 13},
+	{0, 1},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 8},
+	{0, 27},
+	{0, 2},
+	{0, 3},
+	{0, 0},
+	{0, 0},
+	{0, 4},
+	{0, 1},
+	{0, 3},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 8},
+	{0, 1},
+	{0, 0},
+	{0, 11},
+	{0, 3},
+	{0, 1},
+	{0, 9},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 7},
+	{0, 5},
+	{0, 35},
+	{0, 10},
+	{0, 4},
+	{0, 3},
+	{0, 7},
+	{0, 13},
+	{0, 39},
+	{0, 0},
+	{0, 13},
+	{0, 0},
+	{0, 5},
+	{0, 0},
+	{0, 0},
+	{0, 17},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 1},
+	{0, 22},
+	{0, 0},
+	{0, 29},
+	{0, 1},
+	{0, 2},
+	{0, 19},
+	{0, 3},
+	{0, 8},
+	{0, 3},
+	{0, 0},
+	{0, 7},
+	{0, 20},
+	{0, 2},
+	{0, 6},
+	{0, 1},
+	{0, 6},
+	{0, 4},
+	{0, 0},
+	{0, 0},
+	{0, 22},
+	{0, 6},
+	{0, 0},
+	{0, 0},
+	{0, 16},
+	{0, 7},
+	{0, 1},
+	{0, 0},
+	{0, 0},
+	{0, 1},
+	{0, 0},
+	{0, 12},
+	{0, 8},
+	{0, 3},
+	{0, 1},
+	{0, 17},
+	{0, 4},
+	{0, 1},
+	{0, 4},
+	{0, 1},
+	{0, 4},
+	{0, 0},
+	{0, 18},
+	{0, 4},
+	{0, 0},
+	{0, 2},
+	{0, 0},
+	{0, 58},
+	{0, 0},
+	{0, 2},
+	{0, 17},
+	{0, 2},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 0},
+	{0, 2},
+	{0, 3},
+	{0, 6},
+};
+
+static const unsigned short builtin_licence_slots[BUILTIN_LICENCE_SLOTS] = {
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	538,
+	479,
+	BUILTIN_LICENCE_NO_SLOT,
+	877,
+	518,
+	484,
+	908,
+	764,
+	533,
+	248,
+	350,
+	372,
+	240,
+	878,
+	894,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	842,
+	145,
+	BUILTIN_LICENCE_NO_SLOT,
+	37,
+	132,
+	835,
+	506,
+	446,
+	444,
+	411,
+	885,
+	445,
+	470,
+	866,
+	256,
+	730,
+	225,
+	456,
+	BUILTIN_LICENCE_NO_SLOT,
+	780,
+	390,
+	0,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	123,
+	BUILTIN_LICENCE_NO_SLOT,
+	567,
+	155,
+	756,
+	114,
+	49,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	685,
+	423,
+	249,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	457,
+	828,
+	179,
+	38,
+	373,
+	54,
+	178,
+	122,
+	605,
+	905,
+	440,
+	627,
+	466,
+	623,
+	5,
+	527,
+	265,
+	622,
+	684,
+	830,
+	215,
+	772,
+	369,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	657,
+	339,
+	BUILTIN_LICENCE_NO_SLOT,
+	658,
+	917,
+	308,
+	839,
+	BUILTIN_LICENCE_NO_SLOT,
+	430,
+	354,
+	81,
+	676,
+	BUILTIN_LICENCE_NO_SLOT,
+	804,
+	699,
+	510,
+	300,
+	887,
+	238,
+	234,
+	629,
+	729,
+	273,
+	205,
+	239,
+	26,
+	143,
+	872,
+	930,
+	498,
+	371,
+	330,
+	584,
+	831,
+	419,
+	96,
+	662,
+	282,
+	720,
+	795,
+	777,
+	387,
+	708,
+	224,
+	893,
+	601,
+	570,
+	588,
+	72,
+	823,
+	79,
+	557,
+	50,
+	913,
+	787,
+	344,
+	817,
+	59,
+	28,
+	496,
+	926,
+	152,
+	750,
+	BUILTIN_LICENCE_NO_SLOT,
+	728,
+	561,
+	488,
+	490,
+	539,
+	701,
+	722,
+	177,
+	21,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	765,
+	BUILTIN_LICENCE_NO_SLOT,
+	874,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	865,
+	165,
+	822,
+	721,
+	781,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	127,
+	458,
+	BUILTIN_LICENCE_NO_SLOT,
+	331,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	782,
+	385,
+	412,
+	BUILTIN_LICENCE_NO_SLOT,
+	751,
+	895,
+	902,
+	BUILTIN_LICENCE_NO_SLOT,
+	384,
+	84,
+	697,
+	698,
+	432,
+	903,
+	650,
+	382,
+	620,
+	515,
+	883,
+	504,
+	482,
+	94,
+	141,
+	505,
+	32,
+	BUILTIN_LICENCE_NO_SLOT,
+	349,
+	182,
+	142,
+	833,
+	56,
+	361,
+	610,
+	426,
+	806,
+	352,
+	646,
+	247,
+	58,
+	671,
+	464,
+	BUILTIN_LICENCE_NO_SLOT,
+	492,
+	199,
+	486,
+	680,
+	65,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	148,
+	BUILTIN_LICENCE_NO_SLOT,
+	562,
+	180,
+	BUILTIN_LICENCE_NO_SLOT,
+	360,
+	151,
+	283,
+	138,
+	BUILTIN_LICENCE_NO_SLOT,
+	531,
+	933,
+	663,
+	90,
+	725,
+	489,
+	571,
+	181,
+	332,
+	424,
+	915,
+	366,
+	337,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	512,
+	14,
+	BUILTIN_LICENCE_NO_SLOT,
+	718,
+	880,
+	BUILTIN_LICENCE_NO_SLOT,
+	311,
+	175,
+	829,
+	BUILTIN_LICENCE_NO_SLOT,
+	803,
+	553,
+	569,
+	459,
+	665,
+	882,
+	BUILTIN_LICENCE_NO_SLOT,
+	770,
+	334,
+	144,
+	211,
+	BUILTIN_LICENCE_NO_SLOT,
+	491,
+	755,
+	204,
+	BUILTIN_LICENCE_NO_SLOT,
+	418,
+	BUILTIN_LICENCE_NO_SLOT,
+	696,
+	BUILTIN_LICENCE_NO_SLOT,
+	695,
+	589,
+	886,
+	618,
+	25,
+	617,
+	BUILTIN_LICENCE_NO_SLOT,
+	529,
+	140,
+	921,
+	316,
+	69,
+	78,
+	400,
+	703,
+	55,
+	BUILTIN_LICENCE_NO_SLOT,
+	396,
+	112,
+	156,
+	644,
+	551,
+	158,
+	162,
+	192,
+	160,
+	648,
+	450,
+	113,
+	731,
+	891,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	402,
+	892,
+	147,
+	201,
+	398,
+	324,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	133,
+	625,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	82,
+	747,
+	726,
+	854,
+	707,
+	61,
+	734,
+	904,
+	BUILTIN_LICENCE_NO_SLOT,
+	376,
+	BUILTIN_LICENCE_NO_SLOT,
+	1,
+	BUILTIN_LICENCE_NO_SLOT,
+	104,
+	105,
+	48,
+	672,
+	277,
+	BUILTIN_LICENCE_NO_SLOT,
+	827,
+	BUILTIN_LICENCE_NO_SLOT,
+	686,
+	233,
+	682,
+	326,
+	333,
+	763,
+	652,
+	270,
+	715,
+	BUILTIN_LICENCE_NO_SLOT,
+	310,
+	420,
+	760,
+	329,
+	186,
+	727,
+	BUILTIN_LICENCE_NO_SLOT,
+	232,
+	342,
+	389,
+	591,
+	391,
+	394,
+	794,
+	BUILTIN_LICENCE_NO_SLOT,
+	495,
+	776,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	705,
+	507,
+	741,
+	194,
+	381,
+	463,
+	632,
+	66,
+	328,
+	849,
+	46,
+	67,
+	560,
+	226,
+	461,
+	171,
+	115,
+	436,
+	422,
+	775,
+	196,
+	668,
+	438,
+	590,
+	184,
+	451,
+	790,
+	427,
+	573,
+	392,
+	307,
+	851,
+	855,
+	442,
+	4,
+	284,
+	879,
+	130,
+	478,
+	836,
+	677,
+	508,
+	745,
+	365,
+	678,
+	859,
+	379,
+	299,
+	131,
+	513,
+	172,
+	57,
+	936,
+	323,
+	469,
+	327,
+	621,
+	821,
+	170,
+	325,
+	919,
+	134,
+	791,
+	674,
+	524,
+	511,
+	679,
+	773,
+	514,
+	858,
+	843,
+	BUILTIN_LICENCE_NO_SLOT,
+	169,
+	633,
+	BUILTIN_LICENCE_NO_SLOT,
+	647,
+	935,
+	409,
+	683,
+	890,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	60,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	540,
+	814,
+	74,
+	237,
+	BUILTIN_LICENCE_NO_SLOT,
+	575,
+	792,
+	BUILTIN_LICENCE_NO_SLOT,
+	43,
+	BUILTIN_LICENCE_NO_SLOT,
+	45,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	525,
+	44,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	128,
+	710,
+	51,
+	BUILTIN_LICENCE_NO_SLOT,
+	666,
+	778,
+	353,
+	856,
+	259,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	636,
+	290,
+	35,
+	31,
+	473,
+	29,
+	929,
+	345,
+	207,
+	8,
+	898,
+	825,
+	274,
+	129,
+	318,
+	499,
+	474,
+	193,
+	341,
+	889,
+	739,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	213,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	500,
+	260,
+	927,
+	223,
+	338,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	667,
+	135,
+	BUILTIN_LICENCE_NO_SLOT,
+	735,
+	431,
+	188,
+	477,
+	336,
+	520,
+	428,
+	736,
+	22,
+	320,
+	23,
+	86,
+	168,
+	246,
+	335,
+	609,
+	77,
+	724,
+	164,
+	558,
+	95,
+	532,
+	262,
+	118,
+	BUILTIN_LICENCE_NO_SLOT,
+	543,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	819,
+	367,
+	BUILTIN_LICENCE_NO_SLOT,
+	796,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	203,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	811,
+	33,
+	34,
+	631,
+	322,
+	912,
+	774,
+	813,
+	487,
+	279,
+	844,
+	494,
+	280,
+	585,
+	704,
+	613,
+	120,
+	586,
+	602,
+	612,
+	862,
+	439,
+	107,
+	868,
+	313,
+	630,
+	18,
+	255,
+	68,
+	228,
+	BUILTIN_LICENCE_NO_SLOT,
+	761,
+	769,
+	BUILTIN_LICENCE_NO_SLOT,
+	528,
+	BUILTIN_LICENCE_NO_SLOT,
+	793,
+	410,
+	475,
+	83,
+	582,
+	643,
+	688,
+	762,
+	287,
+	694,
+	102,
+	121,
+	493,
+	592,
+	212,
+	746,
+	254,
+	433,
+	222,
+	208,
+	125,
+	681,
+	2,
+	443,
+	267,
+	603,
+	167,
+	545,
+	583,
+	497,
+	108,
+	70,
+	552,
+	231,
+	BUILTIN_LICENCE_NO_SLOT,
+	503,
+	BUILTIN_LICENCE_NO_SLOT,
+	85,
+	BUILTIN_LICENCE_NO_SLOT,
+	383,
+	374,
+	537,
+	723,
+	516,
+	295,
+	467,
+	838,
+	521,
+	853,
+	449,
+	75,
+	217,
+	252,
+	253,
+	176,
+	200,
+	852,
+	291,
+	297,
+	638,
+	931,
+	641,
+	359,
+	41,
+	860,
+	861,
+	198,
+	483,
+	437,
+	314,
+	748,
+	209,
+	597,
+	BUILTIN_LICENCE_NO_SLOT,
+	846,
+	288,
+	692,
+	626,
+	598,
+	649,
+	460,
+	554,
+	20,
+	785,
+	754,
+	616,
+	579,
+	346,
+	263,
+	244,
+	906,
+	281,
+	901,
+	261,
+	628,
+	863,
+	596,
+	850,
+	550,
+	111,
+	91,
+	544,
+	509,
+	580,
+	594,
+	541,
+	832,
+	434,
+	139,
+	227,
+	693,
+	257,
+	848,
+	15,
+	563,
+	BUILTIN_LICENCE_NO_SLOT,
+	480,
+	124,
+	404,
+	559,
+	546,
+	351,
+	462,
+	286,
+	278,
+	536,
+	363,
+	216,
+	230,
+	294,
+	454,
+	743,
+	BUILTIN_LICENCE_NO_SLOT,
+	634,
+	808,
+	30,
+	452,
+	421,
+	801,
+	3,
+	712,
+	922,
+	BUILTIN_LICENCE_NO_SLOT,
+	340,
+	595,
+	574,
+	611,
+	355,
+	27,
+	841,
+	655,
+	220,
+	547,
+	166,
+	581,
+	857,
+	190,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	519,
+	264,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	71,
+	BUILTIN_LICENCE_NO_SLOT,
+	441,
+	690,
+	691,
+	16,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	614,
+	275,
+	615,
+	245,
+	845,
+	242,
+	243,
+	749,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	302,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	407,
+	576,
+	607,
+	425,
+	236,
+	185,
+	315,
+	406,
+	183,
+	BUILTIN_LICENCE_NO_SLOT,
+	97,
+	670,
+	266,
+	800,
+	89,
+	485,
+	447,
+	472,
+	13,
+	738,
+	BUILTIN_LICENCE_NO_SLOT,
+	530,
+	364,
+	717,
+	414,
+	938,
+	656,
+	939,
+	153,
+	304,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	807,
+	53,
+	669,
+	566,
+	BUILTIN_LICENCE_NO_SLOT,
+	375,
+	92,
+	568,
+	476,
+	645,
+	BUILTIN_LICENCE_NO_SLOT,
+	119,
+	405,
+	587,
+	535,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	875,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	826,
+	BUILTIN_LICENCE_NO_SLOT,
+	784,
+	881,
+	BUILTIN_LICENCE_NO_SLOT,
+	687,
+	BUILTIN_LICENCE_NO_SLOT,
+	88,
+	386,
+	522,
+	306,
+	413,
+	415,
+	136,
+	268,
+	435,
+	702,
+	608,
+	752,
+	221,
+	501,
+	64,
+	146,
+	397,
+	932,
+	BUILTIN_LICENCE_NO_SLOT,
+	19,
+	370,
+	388,
+	149,
+	42,
+	653,
+	564,
+	312,
+	771,
+	87,
+	BUILTIN_LICENCE_NO_SLOT,
+	709,
+	873,
+	788,
+	11,
+	12,
+	664,
+	356,
+	907,
+	BUILTIN_LICENCE_NO_SLOT,
+	716,
+	810,
+	660,
+	918,
+	502,
+	934,
+	BUILTIN_LICENCE_NO_SLOT,
+	399,
+	768,
+	BUILTIN_LICENCE_NO_SLOT,
+	599,
+	214,
+	517,
+	429,
+	73,
+	99,
+	47,
+	358,
+	937,
+	348,
+	269,
+	154,
+	BUILTIN_LICENCE_NO_SLOT,
+	766,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	888,
+	BUILTIN_LICENCE_NO_SLOT,
+	925,
+	52,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	753,
+	BUILTIN_LICENCE_NO_SLOT,
+	285,
+	401,
+	565,
+	465,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	651,
+	799,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	802,
+	BUILTIN_LICENCE_NO_SLOT,
+	39,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	455,
+	BUILTIN_LICENCE_NO_SLOT,
+	116,
+	911,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	24,
+	818,
+	711,
+	797,
+	786,
+	661,
+	63,
+	62,
+	713,
+	BUILTIN_LICENCE_NO_SLOT,
+	448,
+	870,
+	BUILTIN_LICENCE_NO_SLOT,
+	534,
+	526,
+	642,
+	BUILTIN_LICENCE_NO_SLOT,
+	798,
+	BUILTIN_LICENCE_NO_SLOT,
+	767,
+	258,
+	523,
+	BUILTIN_LICENCE_NO_SLOT,
+	914,
+	362,
+	BUILTIN_LICENCE_NO_SLOT,
+	357,
+	837,
+	9,
+	BUILTIN_LICENCE_NO_SLOT,
+	673,
+	10,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	659,
+	928,
+	897,
+	640,
+	468,
+	757,
+	BUILTIN_LICENCE_NO_SLOT,
+	296,
+	408,
+	195,
+	317,
+	321,
+	319,
+	106,
+	840,
+	BUILTIN_LICENCE_NO_SLOT,
+	706,
+	93,
+	218,
+	920,
+	189,
+	292,
+	578,
+	BUILTIN_LICENCE_NO_SLOT,
+	900,
+	271,
+	235,
+	779,
+	549,
+	732,
+	733,
+	BUILTIN_LICENCE_NO_SLOT,
+	103,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	758,
+	471,
+	871,
+	453,
+	759,
+	150,
+	187,
+	577,
+	157,
+	241,
+	635,
+	210,
+	395,
+	416,
+	343,
+	899,
+	481,
+	675,
+	606,
+	101,
+	847,
+	572,
+	100,
+	654,
+	40,
+	916,
+	548,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	719,
+	700,
+	639,
+	BUILTIN_LICENCE_NO_SLOT,
+	742,
+	809,
+	834,
+	864,
+	BUILTIN_LICENCE_NO_SLOT,
+	378,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	159,
+	815,
+	869,
+	867,
+	714,
+	347,
+	76,
+	816,
+	174,
+	BUILTIN_LICENCE_NO_SLOT,
+	619,
+	173,
+	BUILTIN_LICENCE_NO_SLOT,
+	417,
+	BUILTIN_LICENCE_NO_SLOT,
+	298,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	377,
+	126,
+	276,
+	924,
+	805,
+	637,
+	923,
+	820,
+	80,
+	BUILTIN_LICENCE_NO_SLOT,
+	542,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	293,
+	BUILTIN_LICENCE_NO_SLOT,
+	137,
+	197,
+	789,
+	272,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	309,
+	689,
+	161,
+	884,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	403,
+	202,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	219,
+	BUILTIN_LICENCE_NO_SLOT,
+	7,
+	BUILTIN_LICENCE_NO_SLOT,
+	744,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	36,
+	393,
+	109,
+	737,
+	BUILTIN_LICENCE_NO_SLOT,
+	163,
+	BUILTIN_LICENCE_NO_SLOT,
+	824,
+	305,
+	229,
+	301,
+	303,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	110,
+	812,
+	191,
+	600,
+	BUILTIN_LICENCE_NO_SLOT,
+	604,
+	17,
+	740,
+	BUILTIN_LICENCE_NO_SLOT,
+	555,
+	BUILTIN_LICENCE_NO_SLOT,
+	6,
+	BUILTIN_LICENCE_NO_SLOT,
+	876,
+	BUILTIN_LICENCE_NO_SLOT,
+	206,
+	556,
+	624,
+	BUILTIN_LICENCE_NO_SLOT,
+	251,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	910,
+	250,
+	98,
+	380,
+	593,
+	BUILTIN_LICENCE_NO_SLOT,
+	BUILTIN_LICENCE_NO_SLOT,
+	289,
+	368,
+	909,
+	896,
+	783,
+	117,
+};
+
+#endif
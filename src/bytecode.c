@@ -0,0 +1,266 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/buffers.h"
+#include "src/bytecode.h"
+#include "src/licences.h"
+#include "src/options.h"
+#include "src/stringutils.h"
+
+static void put_u16(unsigned char *dst, const size_t value) {
+	dst[0] = (value >> 8) & 0xFF;
+	dst[1] = value & 0xFF;
+}
+
+static size_t get_u16(const unsigned char *src) {
+	return (((size_t)src[0]) << 8) | src[1];
+}
+
+// Returns the stack height needed to evaluate the subtree, or 0 on failure.
+static size_t encode_node(const struct LicenceTreeNode *node, const char *base, struct ReBuffer *out) {
+	if(node->type == LTNT_LICENCE) {
+		// Leaves pointing outside of the base string end up with a huge offset.
+		const size_t offset = (size_t)(node->licence - base);
+		const size_t length = strlen(node->licence);
+		if((offset > 0xFFFF) || (length > 0xFFFF)) return 0;
+
+		// The whole verdict mask is kept, so --explain can colour leaves per list.
+		unsigned char leaf[BYTECODE_LEAF_SIZE] = { BYTECODE_LEAF, (unsigned char)node->is_free };
+		put_u16(leaf + 2, offset);
+		put_u16(leaf + 4, length);
+		return (rebuf_append(out, leaf, sizeof(leaf)) != NULL) ? 1 : 0;
+	}
+
+	if(node->members > 0xFFFF) return 0;
+
+	// Members are evaluated one after another, with the results
+	// of the previous ones waiting on the stack.
+	size_t height = 1;
+	for(unsigned int m = 0; m < node->members; ++m) {
+		const size_t member_height = encode_node(node->child[m], base, out);
+		if(member_height == 0) return 0;
+		if(m + member_height > height) height = m + member_height;
+	}
+
+	unsigned char op[BYTECODE_OP_SIZE] = { (node->type == LTNT_AND) ? BYTECODE_AND : BYTECODE_OR };
+	put_u16(op + 1, node->members);
+	return (rebuf_append(out, op, sizeof(op)) != NULL) ? height : 0;
+}
+
+int bytecode_encode(const struct LicenceTreeNode *tree, const char *base, struct ReBuffer *out) {
+	const size_t start = out->used;
+
+	const unsigned char header[BYTECODE_HEADER_SIZE] = { 0 };
+	if(rebuf_append(out, header, sizeof(header)) == NULL) return -1;
+
+	const size_t height = encode_node(tree, base, out);
+	const size_t size = out->used - start;
+	if((height == 0) || (height > BYTECODE_MAX_HEIGHT) || (size > 0xFFFF)) {
+		out->used = start;
+		return -1;
+	}
+
+	unsigned char *code = ((unsigned char*)out->data) + start;
+	put_u16(code, size);
+	put_u16(code + 2, height);
+	return 0;
+}
+
+size_t bytecode_size(const unsigned char *code) {
+	return get_u16(code);
+}
+
+// An AND of nothing is free according to all of the lists, while an OR of nothing
+// is not free according to any of them - same as in the classifiers.
+static unsigned char fold_start(const unsigned char op) {
+	return (op == BYTECODE_AND) ? (unsigned char)((1u << opt_licencelistcount) - 1) : 0x00;
+}
+
+static unsigned char fold_step(const unsigned char op, const unsigned char result, const unsigned char value) {
+	return (op == BYTECODE_AND) ? (result & value) : (result | value);
+}
+
+unsigned int bytecode_evaluate(const unsigned char *code) {
+	unsigned char stack[BYTECODE_MAX_HEIGHT];
+	size_t height = 0;
+
+	const size_t size = get_u16(code);
+	for(size_t pos = BYTECODE_HEADER_SIZE; pos < size;) {
+		if(code[pos] == BYTECODE_LEAF) {
+			stack[height++] = code[pos + 1];
+			pos += BYTECODE_LEAF_SIZE;
+		} else {
+			const size_t members = get_u16(code + pos + 1);
+			height -= members;
+
+			unsigned char result = fold_start(code[pos]);
+			for(size_t m = 0; m < members; ++m) result = fold_step(code[pos], result, stack[height + m]);
+			stack[height++] = result;
+			pos += BYTECODE_OP_SIZE;
+		}
+	}
+	return (height == 1) ? stack[0] : 0;
+}
+
+/*
+ * Rendering works the same way as evaluation, except that the stack holds
+ * pieces of text instead of verdicts. Since members are rendered one after
+ * another, the pieces belonging to an AND/OR node always lie next to each
+ * other at the end of the output buffer, and can be joined in place.
+ */
+struct Fragment {
+	size_t start; // Offset of the fragment's text in the output buffer
+	unsigned char mask;
+	unsigned char is_group;
+};
+
+static int append_string(struct ReBuffer *buf, const char *str) {
+	return (rebuf_append(buf, str, strlen(str)) != NULL) ? 0 : -1;
+}
+
+static int append_json_string(struct ReBuffer *buf, const char *str, const size_t len) {
+	if(append_string(buf, "\"") != 0) return -1;
+	for(size_t i = 0; i < len; ++i) {
+		const unsigned char c = str[i];
+		char escaped[8];
+		if((c == '"') || (c == '\\')) {
+			snprintf(escaped, sizeof(escaped), "\\%c", c);
+		} else if(c < 0x20) {
+			snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+		} else {
+			if(rebuf_append(buf, &c, 1) == NULL) return -1;
+			continue;
+		}
+		if(append_string(buf, escaped) != 0) return -1;
+	}
+	return append_string(buf, "\"");
+}
+
+static int render_leaf(struct ReBuffer *text, const char *name, const size_t len, const unsigned char mask, const int json) {
+	const int is_free = mask & 1;
+	if(json) {
+		if(append_string(text, "{\"licence\":") != 0) return -1;
+		if(append_json_string(text, name, len) != 0) return -1;
+		return append_string(text, is_free ? ",\"free\":true}" : ",\"free\":false}");
+	}
+
+	if(opt_colour && (append_string(text, is_free ? ANSI_GREEN : ANSI_RED) != 0)) return -1;
+	if(rebuf_append(text, name, len) == NULL) return -1;
+	if(opt_colour && (append_string(text, ANSI_RESET) != 0)) return -1;
+	return 0;
+}
+
+// Join the last "count" fragments, writing the result to the scratch buffer.
+static int render_op(struct ReBuffer *scratch, const struct ReBuffer *text, const struct Fragment *members, const size_t count, const unsigned char op, const unsigned char mask, const int json) {
+	scratch->used = 0;
+
+	const char *joiner;
+	if(json) {
+		const char *type = (op == BYTECODE_AND) ? "and" : "or";
+		const char *is_free = (mask & 1) ? "true" : "false";
+
+		char prefix[64];
+		snprintf(prefix, sizeof(prefix), "{\"type\":\"%s\",\"free\":%s,\"members\":[", type, is_free);
+		if(append_string(scratch, prefix) != 0) return -1;
+		joiner = ",";
+	} else {
+		// Same as in licence_printNode().
+		joiner = (opt_grammar != OPT_GRAMMAR_LOOSE)
+			? ((op == BYTECODE_AND) ? " AND " : " OR ")
+			: ((op == BYTECODE_AND) ? " and " : " or ");
+	}
+
+	for(size_t m = 0; m < count; ++m) {
+		const size_t start = members[m].start;
+		const size_t end = (m + 1 < count) ? members[m + 1].start : text->used;
+		const int parenthesise = !json && members[m].is_group;
+
+		if(parenthesise && (append_string(scratch, "(") != 0)) return -1;
+		if(rebuf_append(scratch, ((const char*)text->data) + start, end - start) == NULL) return -1;
+		if(parenthesise && (append_string(scratch, ")") != 0)) return -1;
+		if((m + 1 < count) && (append_string(scratch, joiner) != 0)) return -1;
+	}
+
+	if(json && (append_string(scratch, "]}") != 0)) return -1;
+	return 0;
+}
+
+static int render(FILE *file, const unsigned char *code, const char *base, const int json) {
+	struct ReBuffer *text = rebuf_init(256);
+	struct ReBuffer *scratch = rebuf_init(256);
+	struct ReBuffer *fragments = rebuf_init(16 * sizeof(struct Fragment));
+	if((text == NULL) || (scratch == NULL) || (fragments == NULL)) goto fail;
+
+	const size_t size = get_u16(code);
+	for(size_t pos = BYTECODE_HEADER_SIZE; pos < size;) {
+		if(code[pos] == BYTECODE_LEAF) {
+			const struct Fragment leaf = { .start = text->used, .mask = code[pos + 1], .is_group = 0 };
+			if(rebuf_append(fragments, &leaf, sizeof(leaf)) == NULL) goto fail;
+
+			const char *name = base + get_u16(code + pos + 2);
+			if(render_leaf(text, name, get_u16(code + pos + 4), leaf.mask, json) != 0) goto fail;
+
+			pos += BYTECODE_LEAF_SIZE;
+			continue;
+		}
+
+		const size_t members = get_u16(code + pos + 1);
+		const size_t first = (fragments->used / sizeof(struct Fragment)) - members;
+		struct Fragment *stack = fragments->data;
+
+		struct Fragment group = {
+			.start = (members > 0) ? stack[first].start : text->used,
+			.mask = fold_start(code[pos]),
+			.is_group = 1,
+		};
+		for(size_t m = 0; m < members; ++m) group.mask = fold_step(code[pos], group.mask, stack[first + m].mask);
+
+		if(render_op(scratch, text, stack + first, members, code[pos], group.mask, json) != 0) goto fail;
+
+		text->used = group.start;
+		if(rebuf_append(text, scratch->data, scratch->used) == NULL) goto fail;
+
+		fragments->used = first * sizeof(struct Fragment);
+		if(rebuf_append(fragments, &group, sizeof(group)) == NULL) goto fail;
+
+		pos += BYTECODE_OP_SIZE;
+	}
+
+	fwrite(text->data, 1, text->used, file);
+	rebuf_free(text);
+	rebuf_free(scratch);
+	rebuf_free(fragments);
+	return 0;
+
+	fail: {
+		rebuf_free(text);
+		rebuf_free(scratch);
+		rebuf_free(fragments);
+		return -1;
+	}
+}
+
+int bytecode_print(FILE *file, const unsigned char *code, const char *base) {
+	return render(file, code, base, 0);
+}
+
+int bytecode_printJSON(FILE *file, const unsigned char *code, const char *base) {
+	return render(file, code, base, 1);
+}
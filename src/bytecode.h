@@ -0,0 +1,77 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_BYTECODE_H
+#define VRMS_RPM_BYTECODE_H
+
+#include <stdio.h>
+
+#include "src/buffers.h"
+#include "src/licences.h"
+
+/*
+ * A compact, contiguous encoding of licence trees.
+ *
+ * The tree is stored in postfix order: first the children, then the operator
+ * joining them. Leaves do not hold pointers - the licence name is referenced
+ * by its offset and length within the licence string the tree was built from.
+ * This makes the code relocatable, so it can be copied around or written
+ * to a file as-is.
+ *
+ * Layout (all multi-byte values are big-endian):
+ *   header:  u16 total size (including the header), u16 evaluation stack height
+ *   leaf:    BYTECODE_LEAF, u8 verdict mask, u16 offset, u16 length
+ *   and/or:  BYTECODE_AND / BYTECODE_OR, u16 number of members
+ *
+ * The verdict mask has bit 0 set when the leaf licence is free.
+ */
+
+#define BYTECODE_LEAF  0x01
+#define BYTECODE_AND   0x02
+#define BYTECODE_OR    0x03
+
+#define BYTECODE_HEADER_SIZE  4
+#define BYTECODE_LEAF_SIZE    6
+#define BYTECODE_OP_SIZE      3
+
+// Deepest evaluation stack supported. This is always enough for trees
+// built from licence strings shorter than 4096 characters.
+#define BYTECODE_MAX_HEIGHT  2048
+
+// Encode the tree and append the code to the buffer.
+// The tree's leaves must point into the "base" string.
+// Returns 0 on success and -1 on failure.
+extern int bytecode_encode(const struct LicenceTreeNode *tree, const char *base, struct ReBuffer *out);
+
+// Total size of the code, in bytes.
+extern size_t bytecode_size(const unsigned char *code);
+
+// Evaluate the code and return the verdict mask of the whole expression.
+extern unsigned int bytecode_evaluate(const unsigned char *code);
+#define bytecode_isFree(code)  (bytecode_evaluate(code) & 1)
+
+// Print the expression in the same way as licence_printNode().
+// Returns 0 on success and -1 on failure.
+extern int bytecode_print(FILE *file, const unsigned char *code, const char *base);
+
+// Print the expression as a JSON object. Leaves are printed as
+//   {"licence":"name","free":true}
+// while AND/OR nodes are printed as
+//   {"type":"and","free":false,"members":[...]}
+// Returns 0 on success and -1 on failure.
+extern int bytecode_printJSON(FILE *file, const unsigned char *code, const char *base);
+
+#endif
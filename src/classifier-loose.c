@@ -21,14 +21,18 @@
 #include "src/buffers.h"
 #include "src/classifiers.h"
 #include "src/licences.h"
+#include "src/stats.h"
 #include "src/stringutils.h"
 
 #define LIST_COUNT(data) ((data)->list->used / sizeof(char*))
 
 struct LooseClassifier {
 	struct LicenceClassifier interface;
-	const struct LicenceData *data;
+	const struct LicenceData *data[LICENCE_LISTS_MAX];
+	unsigned int dataCount;
+	unsigned int allFree; // Verdict for licences found in all of the lists
 	struct ReBuffer *nodeBuf;
+	unsigned int depth;
 };
 
 // Try to find the WITH operator. The operator is matched in a case-insensitive
@@ -63,7 +67,7 @@ static char* find_WITH_operator(char *licence) {
 	}
 }
 
-static int is_free(const struct LicenceData *data, char *licence) {
+static unsigned int is_free(const struct LooseClassifier *self, char *licence) {
 	// TODO: Multi-word suffixes appear in the list twice: first using
 	//       a space-separated form, and then a hyphen-seperated one.
 	//       Devise some mechanism to get rid of this duplication.
@@ -114,16 +118,16 @@ static int is_free(const struct LicenceData *data, char *licence) {
 			const char oldChar = *with;
 
 			*with = '\0'; // Trim the licence string before lookup
-			const int search = licences_find(data, licence);
+			const unsigned int search = licences_findMask(self->data, self->dataCount, licence);
 			*with = oldChar; // Restore old char
 
 			// It's not possible for a licence string to have two valid suffixes,
 			// so we can return now, without looking through the rest of the suffixes.
-			return search >= 0;
+			return search;
 		}
 	}
 
-	return licences_find(data, licence) >= 0;
+	return licences_findMask(self->data, self->dataCount, licence);
 }
 
 static int is_opening_paren(const char *str) {
@@ -191,82 +195,99 @@ static enum LicenceTreeNodeType detect_type(char *licence) {
 	return LTNT_LICENCE;
 }
 
+// Strip any parentheses surrounding the whole string and return its type.
+static enum LicenceTreeNodeType unwrap(char **licence) {
+	enum LicenceTreeNodeType type;
+	while((type = detect_type(*licence)) == LTNT_PARENTHESISED) {
+		size_t liclen = strlen(*licence);
+		if((*licence)[liclen-1] == ')') (*licence)[liclen-1] = '\0';
+		++(*licence);
+	}
+	return type;
+}
+
+// Split off the next member of an AND/OR expression and advance the cursor.
+// Returns NULL if the member turned out to be empty. Once the whole string
+// has been consumed, the cursor is set to NULL.
+static char* next_member(char **cursor, const enum LicenceTreeNodeType type) {
+	const match_func_t patterns[] = {
+		&is_opening_paren,
+		get_joiner_func(type),
+		NULL
+	};
+
+	char *needle_pos;
+	const int match = str_match_first(*cursor, patterns, &needle_pos);
+	if(match < 0) {
+		size_t trimlen;
+		char *part = trim_extra(*cursor, &trimlen, "()");
+		*cursor = NULL;
+		return (trimlen > 0) ? part : NULL;
+	}
+	if(match == 1) {
+		*needle_pos = '\0';
+
+		size_t partlen;
+		char *part = trim(*cursor, &partlen);
+		*cursor = needle_pos + get_joiner_len(type);
+		return (partlen > 0) ? part : NULL;
+	}
+
+	char *closingparen = find_closing_paren(needle_pos);
+	if(closingparen == NULL) {
+		*cursor = needle_pos + 1;
+		return NULL;
+	}
+	*closingparen = '\0';
+	*cursor = closingparen + 1;
+	return needle_pos + 1;
+}
+
 // Helper macro: make a pointer to a LicenceTreeNode from the value located in the nodeBuf at given offset
 #define NODEBUFPTR(offset) ((struct LicenceTreeNode*)(((char*)self->nodeBuf->data) + (offset)))
 
-static struct LicenceTreeNode* loose_classify(struct LicenceClassifier *class, char* licence) {
-	struct LooseClassifier* self = (struct LooseClassifier*)class;
+static struct LicenceTreeNode* loose_classify(struct LicenceClassifier *class, char* licence);
+static unsigned int loose_evaluate(struct LicenceClassifier *class, char* licence);
 
-	enum LicenceTreeNodeType type;
-	while((type = detect_type(licence)) == LTNT_PARENTHESISED) {
-		size_t liclen = strlen(licence);
-		if(licence[liclen-1] == ')') licence[liclen-1] = '\0';
-		++licence;
-	}
+static struct LicenceTreeNode* classify_node(struct LooseClassifier *self, char* licence) {
+	struct LicenceClassifier *class = &self->interface;
 
+	const enum LicenceTreeNodeType type = unwrap(&licence);
 	if(type == LTNT_LICENCE) {
+		stats_count(TREE_NODE_MALLOCS);
 		struct LicenceTreeNode *node = malloc(sizeof(struct LicenceTreeNode));
 		if(node != NULL) {
 			node->type = LTNT_LICENCE;
 			node->licence = licence;
-			node->is_free = is_free(self->data, licence);
+			node->is_free = is_free(self, licence);
 		}
 		return node;
 	}
 
-	const int joiner_len = get_joiner_len(type);
-	const match_func_t patterns[] = {
-		&is_opening_paren,
-		get_joiner_func(type),
-		NULL
-	};
-
 	const size_t bufStart = self->nodeBuf->used;
-	int isFree = (type == LTNT_AND) ? 1 : 0;
-
-	int match;
-	do {
-		char *needle_pos;
-		match = str_match_first(licence, patterns, &needle_pos);
-
-		struct LicenceTreeNode *child = NULL;
-		if(match < 0) {
-			size_t trimlen;
-			licence = trim_extra(licence, &trimlen, "()");
-			if(trimlen > 0) child = loose_classify(class, licence);
-		} else if(match == 1) {
-			*needle_pos = '\0';
-
-			size_t partlen;
-			char *part = trim(licence, &partlen);
-			if(partlen > 0) child = loose_classify(class, part);
-
-			licence = needle_pos + joiner_len;
-		} else {
-			char *closingparen = find_closing_paren(needle_pos);
-			if(closingparen != NULL) {
-				*closingparen = '\0';
-				child = loose_classify(class, needle_pos + 1);
-				licence = closingparen + 1;
-			} else {
-				licence = needle_pos + 1;
-			}
-		}
+	unsigned int isFree = (type == LTNT_AND) ? self->allFree : 0;
+
+	char *cursor = licence;
+	while(cursor != NULL) {
+		char *member = next_member(&cursor, type);
+		if(member == NULL) continue;
+
+		struct LicenceTreeNode *child = loose_classify(class, member);
+		if(child == NULL) continue;
 
-		if(child != NULL) {
-			if(rebuf_append(self->nodeBuf, &child, sizeof(struct LicenceTreeNode*)) == NULL) {
-				// Appending failed. Free any child nodes allocated so far, and bail out.
-				for(size_t pos = bufStart; bufStart < self->nodeBuf->used; pos += sizeof(struct LicenceTreeNode*)) {
-					licence_freeTree(NODEBUFPTR(pos));
-				}
-				self->nodeBuf->used = bufStart;
-				return NULL;
+		if(rebuf_append(self->nodeBuf, &child, sizeof(struct LicenceTreeNode*)) == NULL) {
+			// Appending failed. Free any child nodes allocated so far, and bail out.
+			for(size_t pos = bufStart; bufStart < self->nodeBuf->used; pos += sizeof(struct LicenceTreeNode*)) {
+				licence_freeTree(NODEBUFPTR(pos));
 			}
-			isFree = (type == LTNT_AND) ? (isFree && child->is_free) : (isFree || child->is_free);
+			self->nodeBuf->used = bufStart;
+			return NULL;
 		}
-	} while(match >= 0);
+		isFree = (type == LTNT_AND) ? (isFree & child->is_free) : (isFree | child->is_free);
+	}
 
 	const size_t bufDataLen = self->nodeBuf->used - bufStart;
+	stats_count(TREE_NODE_MALLOCS);
 	struct LicenceTreeNode *node = malloc(sizeof(struct LicenceTreeNode) + bufDataLen);
 	if(node != NULL) {
 		node->members = bufDataLen / sizeof(struct LicenceTreeNode*);
@@ -280,6 +301,55 @@ static struct LicenceTreeNode* loose_classify(struct LicenceClassifier *class, c
 	return node;
 }
 
+// Same as classify_node(), but only computes the verdict, without building a tree.
+// Stops as soon as the verdict can't change anymore - i.e. once an AND turns out
+// to be non-free, or an OR turns out to be free, according to every list.
+static unsigned int evaluate_node(struct LooseClassifier *self, char* licence) {
+	const enum LicenceTreeNodeType type = unwrap(&licence);
+	if(type == LTNT_LICENCE) return is_free(self, licence);
+
+	unsigned int isFree = (type == LTNT_AND) ? self->allFree : 0;
+	char *cursor = licence;
+	while(cursor != NULL) {
+		char *member = next_member(&cursor, type);
+		if(member == NULL) continue;
+
+		const unsigned int memberFree = loose_evaluate(&self->interface, member);
+		if(type == LTNT_AND) {
+			isFree &= memberFree;
+			if(isFree == 0) break;
+		} else {
+			isFree |= memberFree;
+			if(isFree == self->allFree) break;
+		}
+	}
+	return isFree;
+}
+
+// Wrapper around classify_node(), keeping track of the recursion depth.
+static struct LicenceTreeNode* loose_classify(struct LicenceClassifier *class, char* licence) {
+	struct LooseClassifier* self = (struct LooseClassifier*)class;
+
+	self->depth += 1;
+	stats_max(CLASSIFIER_DEPTH, self->depth);
+	struct LicenceTreeNode *node = classify_node(self, licence);
+	self->depth -= 1;
+
+	return node;
+}
+
+// Wrapper around evaluate_node(), keeping track of the recursion depth.
+static unsigned int loose_evaluate(struct LicenceClassifier *class, char* licence) {
+	struct LooseClassifier* self = (struct LooseClassifier*)class;
+
+	self->depth += 1;
+	stats_max(CLASSIFIER_DEPTH, self->depth);
+	const unsigned int result = evaluate_node(self, licence);
+	self->depth -= 1;
+
+	return result;
+}
+
 static void classifier_free(struct LicenceClassifier *class) {
 	if(class != NULL) {
 		struct LooseClassifier *self = (struct LooseClassifier*)class;
@@ -288,7 +358,9 @@ static void classifier_free(struct LicenceClassifier *class) {
 	}
 }
 
-struct LicenceClassifier* classifier_newLoose(const struct LicenceData *data) {
+struct LicenceClassifier* classifier_newLoose(const struct LicenceData *const *data, unsigned int count) {
+	if((count == 0) || (count > LICENCE_LISTS_MAX)) return NULL;
+
 	struct LooseClassifier *self = malloc(sizeof(struct LooseClassifier));
 	if(self == NULL) return NULL;
 
@@ -298,10 +370,14 @@ struct LicenceClassifier* classifier_newLoose(const struct LicenceData *data) {
 		return NULL;
 	}
 
-	self->data = data;
+	for(unsigned int i = 0; i < count; ++i) self->data[i] = data[i];
+	self->dataCount = count;
+	self->allFree = (1u << count) - 1;
 	self->nodeBuf = nodeBuf;
+	self->depth = 0;
 
 	self->interface.classify = &loose_classify;
+	self->interface.evaluate = &loose_evaluate;
 	self->interface.free = &classifier_free;
 	return &self->interface;
 }
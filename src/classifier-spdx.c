@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2023-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  * Copyright (C) 2023 Marcin "dextero" Radomski
  *
  * This program is free software: you can redistribute it and/or modify
@@ -21,13 +21,17 @@
 #include "src/buffers.h"
 #include "src/classifiers.h"
 #include "src/licences.h"
+#include "src/stats.h"
 #include "src/stringutils.h"
 
 struct SpdxClassifier {
 	struct LicenceClassifier interface;
-	const struct LicenceData *data;
+	const struct LicenceData *data[LICENCE_LISTS_MAX];
+	unsigned int dataCount;
+	unsigned int allFree; // Verdict for licences found in all of the lists
 	struct ReBuffer *nodeBuf;
 	int lenient;
+	unsigned int depth;
 };
 
 enum WithSearchState {
@@ -70,8 +74,9 @@ static char* find_WITH_operator(struct SpdxClassifier *self, char *licence) {
 	return NULL;
 }
 
-static int is_free(struct SpdxClassifier *self, char *licence) {
-	if(licences_find(self->data, licence) >= 0) return 1;
+static unsigned int is_free(struct SpdxClassifier *self, char *licence) {
+	unsigned int found = licences_findMask(self->data, self->dataCount, licence);
+	if(found == self->allFree) return found;
 
 	// SPDX allows specifying additional rights ("licensing exceptions")
 	// through the use of the "WITH" operator.
@@ -106,16 +111,16 @@ static int is_free(struct SpdxClassifier *self, char *licence) {
 	}
 
 	// If we didn't find the "WITH" operator nor the "+" operator, bail out early.
-	if((plusPos >= len) && (with == NULL)) return 0;
+	if((plusPos >= len) && (with == NULL)) return found;
 
 	// Try matching the licence name, stripped from the +/WITH parts, again.
-	int found = licences_find(self->data, licence);
+	found |= licences_findMask(self->data, self->dataCount, licence);
 
 	// Restore the licence string to its original shape.
 	if(plusPos < len) licence[plusPos] = plusChar;
 	if(with != NULL) *with = ' ';
 
-	return found >= 0;
+	return found;
 }
 
 enum DetectionState {
@@ -199,7 +204,7 @@ static enum LicenceTreeNodeType detect_type(struct SpdxClassifier *self, const c
 }
 
 /*
- * Helper function for spdx_classify(), should not be called from other places.
+ * Helper function for next_member(), should not be called from other places.
  *
  * Check if text[0] is followed by "AND"/"OR", and then either a space (' ') or an opening parenthesis ('(').
  * Returns 0 if match is found, or number of characters that can be skipped if it isn't.
@@ -218,7 +223,7 @@ static int skip_non_joiner(struct SpdxClassifier *self, const char *const text,
 	return 0;
 }
 
-static struct LicenceTreeNode* append(struct SpdxClassifier *self, char *licence, enum LicenceTreeNodeType rootType, int *rootIsFree);
+static struct LicenceTreeNode* append(struct SpdxClassifier *self, char *licence, enum LicenceTreeNodeType rootType, unsigned int *rootIsFree);
 static void cleanup(struct SpdxClassifier *self, size_t bufStart);
 
 // Helper macro: append a child node, or bail out if an error occurs
@@ -233,45 +238,20 @@ static void cleanup(struct SpdxClassifier *self, size_t bufStart);
 // Helper macro: make a pointer to a LicenceTreeNode from the value located in the nodeBuf at given offset
 #define NODEBUFPTR(offset) ((struct LicenceTreeNode*)(((char*)self->nodeBuf->data) + (offset)))
 
-static struct LicenceTreeNode* spdx_classify(struct LicenceClassifier *class, char *licence) {
-	struct SpdxClassifier *self = (struct SpdxClassifier*)class;
-
-	enum LicenceTreeNodeType type = detect_type(self, licence);
-	if(type == LTNT_LICENCE) {
-		/*
-		 * If the detected type is LICENCE, but we've got an opening parenthesis,
-		 * then that means one of the two following scenarios:
-		 * 1. The whole string is parenthesized (e.g. "(text)" instead of "text")
-		 * 2. The licence string contains parenthesized text (e.g. "(Very) Bad Licence")
-		 * If we're in scenario 1, strip the parentheses and try again.
-		 */
-		if(*licence == '(') {
-			char *closingParen = find_closing_paren(licence);
-			if((closingParen != NULL) && (*(closingParen + 1) == '\0')) {
-				++licence; // Advance one char to skip the opening paren
-				*closingParen = '\0'; // Shorten the string to remove the closing paren
-				return spdx_classify(class, licence);
-			}
-		}
-
-		struct LicenceTreeNode *node = malloc(sizeof(struct LicenceTreeNode));
-		if(node != NULL) {
-			node->type = LTNT_LICENCE;
-			node->licence = licence;
-			node->is_free = is_free(self, licence);
-		}
-		return node;
-	}
-
-	const size_t bufStart = self->nodeBuf->used;
-	int isFree = (type == LTNT_AND) ? 1 : 0;
+/*
+ * Split off the next member of an AND/OR expression and advance the cursor.
+ * Returns NULL once there are no more members.
+ */
+static char* next_member(struct SpdxClassifier *self, char **cursor, const enum LicenceTreeNodeType type) {
+	char *licence = *cursor;
+	if(licence == NULL) return NULL;
 
 	char *s = licence;
 	while(1) {
 		while((*s != '\0') && (*s != '(') && (*s != ')') && (*s != ' ')) ++s;
 		if(*s == '\0') {
-			if(s > licence) try_append(licence, type, &isFree);
-			break;
+			*cursor = NULL;
+			return (s > licence) ? licence : NULL;
 		}
 		if(*s == '(') {
 			char* closingParen = find_closing_paren(s);
@@ -290,16 +270,64 @@ static struct LicenceTreeNode* spdx_classify(struct LicenceClassifier *class, ch
 		if(*s == ')') ++s;
 		*s = '\0';
 
-		try_append(licence, type, &isFree);
-
 		while((*s != ' ') && (*s != '(')) {
 			*s = '\0';
 			++s;
 		}
-		licence = s;
+		*cursor = s;
+		return licence;
+	}
+}
+
+/*
+ * If the detected type is LICENCE, but we've got an opening parenthesis,
+ * then that means one of the two following scenarios:
+ * 1. The whole string is parenthesized (e.g. "(text)" instead of "text")
+ * 2. The licence string contains parenthesized text (e.g. "(Very) Bad Licence")
+ * In scenario 1, strip the parentheses and return the inner text, so the caller
+ * can try again. Otherwise, return NULL.
+ */
+static char* strip_parentheses(char *licence) {
+	if(*licence != '(') return NULL;
+
+	char *closingParen = find_closing_paren(licence);
+	if((closingParen == NULL) || (*(closingParen + 1) != '\0')) return NULL;
+
+	*closingParen = '\0'; // Shorten the string to remove the closing paren
+	return licence + 1; // Advance one char to skip the opening paren
+}
+
+static struct LicenceTreeNode* spdx_classify(struct LicenceClassifier *class, char *licence);
+static unsigned int spdx_evaluate(struct LicenceClassifier *class, char *licence);
+
+static struct LicenceTreeNode* classify_node(struct SpdxClassifier *self, char *licence) {
+	struct LicenceClassifier *class = &self->interface;
+
+	enum LicenceTreeNodeType type = detect_type(self, licence);
+	if(type == LTNT_LICENCE) {
+		char *inner = strip_parentheses(licence);
+		if(inner != NULL) return spdx_classify(class, inner);
+
+		stats_count(TREE_NODE_MALLOCS);
+		struct LicenceTreeNode *node = malloc(sizeof(struct LicenceTreeNode));
+		if(node != NULL) {
+			node->type = LTNT_LICENCE;
+			node->licence = licence;
+			node->is_free = is_free(self, licence);
+		}
+		return node;
+	}
+
+	const size_t bufStart = self->nodeBuf->used;
+	unsigned int isFree = (type == LTNT_AND) ? self->allFree : 0;
+
+	char *member;
+	while((member = next_member(self, &licence, type)) != NULL) {
+		try_append(member, type, &isFree);
 	}
 
 	const size_t bufDataLen = self->nodeBuf->used - bufStart;
+	stats_count(TREE_NODE_MALLOCS);
 	struct LicenceTreeNode *node = malloc(sizeof(struct LicenceTreeNode) + bufDataLen);
 	if(node != NULL) {
 		node->members = bufDataLen / sizeof(struct LicenceTreeNode*);
@@ -313,7 +341,58 @@ static struct LicenceTreeNode* spdx_classify(struct LicenceClassifier *class, ch
 	return node;
 }
 
-static struct LicenceTreeNode* append(struct SpdxClassifier *self, char *licence, enum LicenceTreeNodeType rootType, int *rootIsFree) {
+// Same as classify_node(), but only computes the verdict, without building a tree.
+// Stops as soon as the verdict can't change anymore - i.e. once an AND turns out
+// to be non-free, or an OR turns out to be free, according to every list.
+static unsigned int evaluate_node(struct SpdxClassifier *self, char *licence) {
+	enum LicenceTreeNodeType type = detect_type(self, licence);
+	if(type == LTNT_LICENCE) {
+		char *inner = strip_parentheses(licence);
+		if(inner != NULL) return spdx_evaluate(&self->interface, inner);
+
+		return is_free(self, licence);
+	}
+
+	unsigned int isFree = (type == LTNT_AND) ? self->allFree : 0;
+	char *member;
+	while((member = next_member(self, &licence, type)) != NULL) {
+		const unsigned int memberFree = spdx_evaluate(&self->interface, trim(member, NULL));
+		if(type == LTNT_AND) {
+			isFree &= memberFree;
+			if(isFree == 0) break;
+		} else {
+			isFree |= memberFree;
+			if(isFree == self->allFree) break;
+		}
+	}
+	return isFree;
+}
+
+// Wrapper around classify_node(), keeping track of the recursion depth.
+static struct LicenceTreeNode* spdx_classify(struct LicenceClassifier *class, char *licence) {
+	struct SpdxClassifier *self = (struct SpdxClassifier*)class;
+
+	self->depth += 1;
+	stats_max(CLASSIFIER_DEPTH, self->depth);
+	struct LicenceTreeNode *node = classify_node(self, licence);
+	self->depth -= 1;
+
+	return node;
+}
+
+// Wrapper around evaluate_node(), keeping track of the recursion depth.
+static unsigned int spdx_evaluate(struct LicenceClassifier *class, char *licence) {
+	struct SpdxClassifier *self = (struct SpdxClassifier*)class;
+
+	self->depth += 1;
+	stats_max(CLASSIFIER_DEPTH, self->depth);
+	const unsigned int result = evaluate_node(self, licence);
+	self->depth -= 1;
+
+	return result;
+}
+
+static struct LicenceTreeNode* append(struct SpdxClassifier *self, char *licence, enum LicenceTreeNodeType rootType, unsigned int *rootIsFree) {
 	licence = trim(licence, NULL);
 
 	struct LicenceTreeNode *child = spdx_classify(&self->interface, licence);
@@ -325,7 +404,7 @@ static struct LicenceTreeNode* append(struct SpdxClassifier *self, char *licence
 		return NULL;
 	}
 
-	*rootIsFree = (rootType == LTNT_AND) ? (*rootIsFree && child->is_free) : (*rootIsFree || child->is_free);
+	*rootIsFree = (rootType == LTNT_AND) ? (*rootIsFree & child->is_free) : (*rootIsFree | child->is_free);
 	return child;
 }
 
@@ -350,7 +429,9 @@ static void spdx_free(struct LicenceClassifier *class) {
 	}
 }
 
-struct LicenceClassifier* classifier_newSPDX(const struct LicenceData *data, int lenient) {
+struct LicenceClassifier* classifier_newSPDX(const struct LicenceData *const *data, unsigned int count, int lenient) {
+	if((count == 0) || (count > LICENCE_LISTS_MAX)) return NULL;
+
 	struct SpdxClassifier *self = malloc(sizeof(struct SpdxClassifier));
 	if(self == NULL) return NULL;
 
@@ -360,11 +441,15 @@ struct LicenceClassifier* classifier_newSPDX(const struct LicenceData *data, int
 		return NULL;
 	}
 
-	self->data = data;
+	for(unsigned int i = 0; i < count; ++i) self->data[i] = data[i];
+	self->dataCount = count;
+	self->allFree = (1u << count) - 1;
 	self->nodeBuf = nodeBuf;
 	self->lenient = lenient;
+	self->depth = 0;
 
 	self->interface.classify = &spdx_classify;
+	self->interface.evaluate = &spdx_evaluate;
 	self->interface.free = &spdx_free;
 	return &self->interface;
 }
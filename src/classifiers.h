@@ -21,10 +21,15 @@
 
 struct LicenceClassifier {
 	struct LicenceTreeNode* (*classify)(struct LicenceClassifier *self, char *licence);
+	// Returns only the verdict (same as LicenceTreeNode.is_free), without allocating a tree.
+	// Like classify(), this may modify the licence string.
+	unsigned int (*evaluate)(struct LicenceClassifier *self, char *licence);
 	void (*free)(struct LicenceClassifier *self);
 };
 
-extern struct LicenceClassifier* classifier_newLoose(const struct LicenceData *data);
-extern struct LicenceClassifier* classifier_newSPDX(const struct LicenceData *data, int lenient);
+// The classifiers check every licence against all of the given lists (at most LICENCE_LISTS_MAX)
+// at once; bit N of each verdict tells whether the licence is free according to list N.
+extern struct LicenceClassifier* classifier_newLoose(const struct LicenceData *const *data, unsigned int count);
+extern struct LicenceClassifier* classifier_newSPDX(const struct LicenceData *const *data, unsigned int count, int lenient);
 
 #endif
@@ -0,0 +1,17 @@
+/**
+ * This file has been auto-generated by generate-config.sh on 2026-10-19, 09:35:42.
+ * Any changes you make here will probably be overwritten by the build system.
+ */
+#ifndef VRMS_RPM_CONFIG_H
+#define VRMS_RPM_CONFIG_H
+
+#define INSTALL_DIR  "/usr/local/share/suve/vrms-rpm"
+#define INSTALL_PREFIX  "/usr/local"
+
+#define ALL_LICENCE_LISTS  "'fedora', 'spdx-fsf-and-osi', 'spdx-fsf-or-osi', 'spdx-only-fsf', \n    'spdx-only-osi', 'suse', 'tweaked'"
+#define DEFAULT_LICENCE_LIST  "tweaked"
+
+#define DEFAULT_GRAMMAR_NAME "loose"
+#define DEFAULT_GRAMMAR_ENUM OPT_GRAMMAR_LOOSE
+
+#endif
@@ -0,0 +1,196 @@
+#!/bin/sh
+#
+# vrms-rpm - list non-free packages on an rpm-based Linux distribution
+# Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License, version 3,
+# as published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+#
+
+set -eu
+
+print_usage() {
+	echo "generate-builtin-licences.sh: This script is not meant to be executed manually." >&2
+	echo "generate-builtin-licences.sh: It is a helper script ran during \"make build\"." >&2
+}
+
+list_name=""
+list_file=""
+
+if [ "$#" -eq 0 ]; then
+	print_usage
+	exit 1
+fi
+
+while getopts 'd:f:' OPTNAME; do
+	case "${OPTNAME}" in
+		d)
+			list_name="${OPTARG}"
+		;;
+
+		f)
+			list_file="${OPTARG}"
+		;;
+
+		*)
+			echo "Unknown option '${OPTNAME}'"
+			exit 1
+		;;
+	esac
+done
+
+if [ -z "${list_name}" ] || [ -z "${list_file}" ]; then
+	print_usage
+	exit 1
+fi
+
+config_date="$(date '+%Y-%m-%d, %H:%M:%S')"
+
+cat <<EOF
+/**
+ * This file has been auto-generated by generate-builtin-licences.sh on ${config_date}.
+ * Any changes you make here will probably be overwritten by the build system.
+ */
+#ifndef VRMS_RPM_BUILTIN_LICENCES_H
+#define VRMS_RPM_BUILTIN_LICENCES_H
+
+#define BUILTIN_LICENCE_LIST  "${list_name}"
+
+EOF
+
+# Fold the list to lowercase, trim whitespace, drop empty lines and sort it
+# (in the C locale, so the order matches what strcasecmp() would produce).
+# Non-ASCII names are handled byte by byte, just like builtin_find() in src/licences.c does.
+#
+# The awk part then builds a perfect hash using the "hash, displace and compress" scheme:
+# - every key is assigned to a bucket using hash #0
+# - for every bucket (starting with the largest ones), find a pair of displacement values
+#   such that (hash #1 + d0 * hash #2 + d1) % SLOTS gives a distinct, free slot for each key
+# The hash functions used here must be kept in sync with builtin_find() in src/licences.c.
+sed -e 's|^[[:space:]]*||' -e 's|[[:space:]]*$||' -e '/^$/d' < "${list_file}" \
+| LC_ALL=C tr '[:upper:]' '[:lower:]' \
+| LC_ALL=C sort -u \
+| LC_ALL=C awk '
+function hash(str, seed, multiplier,    h, i) {
+	h = seed;
+	for(i = 1; i <= length(str); ++i) h = (h * multiplier + ord[substr(str, i, 1)]) % 4294967296;
+	return h;
+}
+
+# Quotes, backslashes, control characters and non-ASCII bytes are written as octal escapes.
+function c_string(str,    out, c, i) {
+	out = "";
+	for(i = 1; i <= length(str); ++i) {
+		c = substr(str, i, 1);
+		if((ord[c] < 32) || (ord[c] > 126) || (c == "\"") || (c == "\\"))
+			out = out sprintf("\\%03o", ord[c]);
+		else
+			out = out c;
+	}
+	return out;
+}
+
+function is_prime(x,    d) {
+	if(x < 2) return 0;
+	for(d = 2; d * d <= x; ++d) if((x % d) == 0) return 0;
+	return 1;
+}
+
+BEGIN {
+	for(i = 1; i < 256; ++i) ord[sprintf("%c", i)] = i;
+	count = 0;
+}
+
+{
+	name[count] = $0;
+	++count;
+}
+
+END {
+	if(count == 0) {
+		print "generate-builtin-licences.sh: licence list is empty" > "/dev/stderr";
+		exit 1;
+	}
+
+	buckets = int(count / 2) + 1;
+	slots = count + int(count / 4) + 1;
+	while(!is_prime(slots)) ++slots;
+
+	max_size = 0;
+	for(b = 0; b < buckets; ++b) size[b] = 0;
+	for(k = 0; k < count; ++k) {
+		b = hash(name[k], 2166136261, 31) % buckets;
+		member[b, size[b]] = k;
+		size[b] += 1;
+		if(size[b] > max_size) max_size = size[b];
+
+		h1[k] = hash(name[k], 5381, 33);
+		h2[k] = hash(name[k], 1, 131);
+	}
+
+	for(s = 0; s < slots; ++s) taken[s] = -1;
+	for(b = 0; b < buckets; ++b) {
+		disp0[b] = 0;
+		disp1[b] = 0;
+	}
+
+	for(bs = max_size; bs > 0; --bs) {
+		for(b = 0; b < buckets; ++b) {
+			if(size[b] != bs) continue;
+
+			found = 0;
+			for(d0 = 0; (d0 < 256) && (!found); ++d0) {
+				for(d1 = 0; (d1 < slots) && (!found); ++d1) {
+					ok = 1;
+					for(m = 0; (m < bs) && ok; ++m) {
+						pos[m] = (h1[member[b, m]] + d0 * h2[member[b, m]] + d1) % slots;
+						if(taken[pos[m]] >= 0) ok = 0;
+						for(p = 0; (p < m) && ok; ++p) if(pos[p] == pos[m]) ok = 0;
+					}
+					if(ok) {
+						found = 1;
+						disp0[b] = d0;
+						disp1[b] = d1;
+						for(m = 0; m < bs; ++m) taken[pos[m]] = member[b, m];
+					}
+				}
+			}
+			if(!found) {
+				print "generate-builtin-licences.sh: failed to build a perfect hash" > "/dev/stderr";
+				exit 1;
+			}
+		}
+	}
+
+	printf "#define BUILTIN_LICENCE_COUNT    %d\n", count;
+	printf "#define BUILTIN_LICENCE_BUCKETS  %d\n", buckets;
+	printf "#define BUILTIN_LICENCE_SLOTS    %d\n", slots;
+	printf "#define BUILTIN_LICENCE_NO_SLOT  0xFFFF\n\n";
+
+	printf "static const char *const builtin_licence_names[BUILTIN_LICENCE_COUNT] = {\n";
+	for(k = 0; k < count; ++k) printf "\t\"%s\",\n", c_string(name[k]);
+	printf "};\n\n";
+
+	printf "static const unsigned short builtin_licence_displacement[BUILTIN_LICENCE_BUCKETS][2] = {\n";
+	for(b = 0; b < buckets; ++b) printf "\t{%d, %d},\n", disp0[b], disp1[b];
+	printf "};\n\n";
+
+	printf "static const unsigned short builtin_licence_slots[BUILTIN_LICENCE_SLOTS] = {\n";
+	for(s = 0; s < slots; ++s) printf "\t%s,\n", (taken[s] >= 0) ? taken[s] : "BUILTIN_LICENCE_NO_SLOT";
+	printf "};\n";
+}
+'
+
+cat <<EOF
+
+#endif
+EOF
@@ -0,0 +1,214 @@
+#!/bin/sh
+#
+# vrms-rpm - list non-free packages on an rpm-based Linux distribution
+# Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License, version 3,
+# as published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+#
+
+
+set -eu
+
+print_usage() {
+	echo "generate-spdx-index.sh: This script is not meant to be executed manually." >&2
+	echo "generate-spdx-index.sh: It is a helper script ran during \"make build\"." >&2
+}
+
+alias_file=""
+index_file=""
+list_name=""
+
+if [ "$#" -eq 0 ]; then
+	print_usage
+	exit 1
+fi
+
+while getopts 'a:f:l:' OPTNAME; do
+	case "${OPTNAME}" in
+		a)
+			alias_file="${OPTARG}"
+		;;
+
+		f)
+			index_file="${OPTARG}"
+		;;
+
+		l)
+			list_name="${OPTARG}"
+		;;
+
+		*)
+			echo "Unknown option '${OPTNAME}'"
+			exit 1
+		;;
+	esac
+done
+
+if [ -z "${index_file}" ]; then
+	print_usage
+	exit 1
+fi
+
+# The licence lists served from the index. Each one is described by a flag mask
+# and whether a licence needs to carry all of the flags, or just any of them.
+# When adding a list here, remember to also add it to SPDX_LICENCE_LISTS in the Makefile.
+policies="
+spdx-fsf-and-osi FO all
+spdx-fsf-or-osi FO any
+spdx-only-fsf F any
+spdx-only-osi O any
+"
+
+# Drop comments and empty lines, then sort the index by the lowercase identifier
+# (in the C locale, so the order matches what strcasecmp() would produce).
+sorted_index() {
+	sed -e '/^#/d' -e '/^[[:space:]]*$/d' < "${index_file}" \
+	| LC_ALL=C awk -F '\t' '{ printf "%s\t%s\t%s\n", tolower($2), $1, $2 }' \
+	| LC_ALL=C sort -t "$(printf '\t')" -k 1,1 -u
+}
+
+# With -l, print the identifiers belonging to a single list, one per line.
+# This is used for generating the built-in list when one of the SPDX lists is the default.
+if [ -n "${list_name}" ]; then
+	sorted_index | LC_ALL=C awk -F '\t' -v list="${list_name}" -v policies="${policies}" '
+	BEGIN {
+		found = 0;
+		count = split(policies, line, "\n");
+		for(i = 1; i <= count; ++i) {
+			if(split(line[i], field, " ") != 3) continue;
+			if(field[1] != list) continue;
+
+			found = 1;
+			flags = field[2];
+			all = (field[3] == "all");
+		}
+		if(!found) {
+			print "generate-spdx-index.sh: unknown list \"" list "\"" > "/dev/stderr";
+			exit 1;
+		}
+	}
+
+	{
+		matched = 0;
+		for(i = 1; i <= length(flags); ++i) {
+			if(index($2, substr(flags, i, 1)) > 0) ++matched;
+		}
+		if(all ? (matched == length(flags)) : (matched > 0)) print $3;
+	}
+	'
+	exit 0
+fi
+
+if [ -z "${alias_file}" ]; then
+	print_usage
+	exit 1
+fi
+
+config_date="$(date '+%Y-%m-%d, %H:%M:%S')"
+
+cat <<EOF
+/**
+ * This file has been auto-generated by generate-spdx-index.sh on ${config_date}.
+ * Any changes you make here will probably be overwritten by the build system.
+ */
+#ifndef VRMS_RPM_SPDX_INDEX_H
+#define VRMS_RPM_SPDX_INDEX_H
+
+#include "src/licences.h"
+
+EOF
+
+sorted_index | LC_ALL=C awk -F '\t' -v policies="${policies}" '
+function flag_bits(str,    bits) {
+	bits = "0";
+	if(index(str, "F") > 0) bits = bits " | SPDX_FLAG_FSF";
+	if(index(str, "O") > 0) bits = bits " | SPDX_FLAG_OSI";
+	if(index(str, "D") > 0) bits = bits " | SPDX_FLAG_DEPRECATED";
+	sub(/^0 \| /, "", bits);
+	return bits;
+}
+
+BEGIN {
+	count = 0;
+}
+
+{
+	name[count] = $3;
+	flags[count] = $2;
+	++count;
+}
+
+END {
+	if(count == 0) {
+		print "generate-spdx-index.sh: the SPDX index is empty" > "/dev/stderr";
+		exit 1;
+	}
+
+	printf "#define SPDX_INDEX_COUNT  %d\n\n", count;
+
+	printf "static const char *const spdx_index_names[SPDX_INDEX_COUNT] = {\n";
+	for(k = 0; k < count; ++k) printf "\t\"%s\",\n", name[k];
+	printf "};\n\n";
+
+	printf "static const unsigned char spdx_index_flags[SPDX_INDEX_COUNT] = {\n";
+	for(k = 0; k < count; ++k) printf "\t%s,\n", flag_bits(flags[k]);
+	printf "};\n\n";
+
+	policy_count = 0;
+	lines = split(policies, line, "\n");
+	for(i = 1; i <= lines; ++i) {
+		if(split(line[i], field, " ") != 3) continue;
+		policy[policy_count] = sprintf("\t{ \"%s\", %s, %d },\n", field[1], flag_bits(field[2]), (field[3] == "all"));
+		++policy_count;
+	}
+
+	printf "#define SPDX_POLICY_COUNT  %d\n\n", policy_count;
+	printf "static const struct SpdxPolicy spdx_policies[SPDX_POLICY_COUNT] = {\n";
+	for(p = 0; p < policy_count; ++p) printf "%s", policy[p];
+	printf "};\n";
+}
+'
+
+# The alias table maps legacy and deprecated names to canonical identifiers.
+# It is sorted the same way as the index, so it can be binary-searched, too.
+sed -e '/^#/d' -e '/^[[:space:]]*$/d' < "${alias_file}" \
+| LC_ALL=C awk -F '\t' '{ printf "%s\t%s\t%s\n", tolower($1), $1, $2 }' \
+| LC_ALL=C sort -t "$(printf '\t')" -k 1,1 -u \
+| LC_ALL=C awk -F '\t' '
+BEGIN {
+	count = 0;
+}
+
+{
+	alias[count] = $2;
+	target[count] = $3;
+	++count;
+}
+
+END {
+	printf "\n#define SPDX_ALIAS_COUNT  %d\n\n", count;
+
+	printf "static const char *const spdx_alias_names[SPDX_ALIAS_COUNT] = {\n";
+	for(k = 0; k < count; ++k) printf "\t\"%s\",\n", alias[k];
+	printf "};\n\n";
+
+	printf "static const char *const spdx_alias_targets[SPDX_ALIAS_COUNT] = {\n";
+	for(k = 0; k < count; ++k) printf "\t\"%s\",\n", target[k];
+	printf "};\n";
+}
+'
+
+cat <<EOF
+
+#endif
+EOF
@@ -0,0 +1,121 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "src/hashmap.h"
+
+#define MIN_CAPACITY 64
+
+// Grow the map once it's 3/4 full, to keep the probe sequences short.
+#define NEEDS_GROWING(map)  (((map)->used + 1) * 4 > (map)->capacity * 3)
+
+size_t hashmap_hash(const char *key, const int case_insensitive) {
+	// FNV-1a
+	size_t hash = 2166136261u;
+	for(; *key != '\0'; ++key) {
+		unsigned char c = *key;
+		if(case_insensitive && (c >= 'A') && (c <= 'Z')) c += 'a' - 'A';
+
+		hash ^= c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static int keys_equal(const struct HashMap *map, const char *a, const char *b) {
+	return (map->case_insensitive ? strcasecmp(a, b) : strcmp(a, b)) == 0;
+}
+
+struct HashMap* hashmap_init(size_t expected, int case_insensitive) {
+	size_t capacity = MIN_CAPACITY;
+	while((capacity * 3) / 4 < expected) capacity *= 2;
+
+	struct HashMap *map = malloc(sizeof(struct HashMap));
+	if(map == NULL) return NULL;
+
+	map->entries = calloc(capacity, sizeof(struct HashMapEntry));
+	if(map->entries == NULL) {
+		free(map);
+		return NULL;
+	}
+
+	map->capacity = capacity;
+	map->used = 0;
+	map->case_insensitive = case_insensitive;
+	return map;
+}
+
+void hashmap_free(struct HashMap *map) {
+	if(map != NULL) {
+		free(map->entries);
+		free(map);
+	}
+}
+
+// Find the slot for the given key: either the one holding it, or the empty one where it should go.
+static struct HashMapEntry* find_slot(const struct HashMap *map, const char *key, const size_t hash) {
+	const size_t mask = map->capacity - 1;
+	for(size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+		struct HashMapEntry *entry = &map->entries[pos];
+		if(entry->key == NULL) return entry;
+		if((entry->hash == hash) && keys_equal(map, entry->key, key)) return entry;
+	}
+}
+
+static int grow(struct HashMap *map) {
+	struct HashMapEntry *old_entries = map->entries;
+	const size_t old_capacity = map->capacity;
+
+	struct HashMapEntry *new_entries = calloc(old_capacity * 2, sizeof(struct HashMapEntry));
+	if(new_entries == NULL) return -1;
+
+	map->entries = new_entries;
+	map->capacity = old_capacity * 2;
+	for(size_t i = 0; i < old_capacity; ++i) {
+		if(old_entries[i].key == NULL) continue;
+		*find_slot(map, old_entries[i].key, old_entries[i].hash) = old_entries[i];
+	}
+
+	free(old_entries);
+	return 0;
+}
+
+struct HashMapEntry* hashmap_find(const struct HashMap *map, const char *key) {
+	struct HashMapEntry *entry = find_slot(map, key, hashmap_hash(key, map->case_insensitive));
+	return (entry->key != NULL) ? entry : NULL;
+}
+
+struct HashMapEntry* hashmap_insert(struct HashMap *map, const char *key) {
+	const size_t hash = hashmap_hash(key, map->case_insensitive);
+
+	struct HashMapEntry *entry = find_slot(map, key, hash);
+	if(entry->key != NULL) return entry;
+
+	if(NEEDS_GROWING(map)) {
+		if(grow(map) != 0) return NULL;
+		entry = find_slot(map, key, hash);
+	}
+
+	entry->key = key;
+	entry->hash = hash;
+	entry->data = NULL;
+	entry->count = 0;
+	map->used += 1;
+	return entry;
+}
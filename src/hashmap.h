@@ -0,0 +1,54 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_HASHMAP_H
+#define VRMS_RPM_HASHMAP_H
+
+#include <stddef.h>
+
+/*
+ * A simple open-addressing hash map, using strings as keys.
+ * The keys are not copied - the caller must make sure they stay valid
+ * for as long as the map is in use.
+ */
+struct HashMapEntry {
+	const char *key;
+	size_t hash;
+	void *data;
+	size_t count;
+};
+
+struct HashMap {
+	struct HashMapEntry *entries;
+	size_t capacity; // Always a power of two
+	size_t used;
+	int case_insensitive; // Fold ASCII letters when hashing and comparing keys
+};
+
+extern struct HashMap* hashmap_init(size_t expected, int case_insensitive);
+extern void hashmap_free(struct HashMap *map);
+
+// Returns NULL if the key is not present in the map.
+extern struct HashMapEntry* hashmap_find(const struct HashMap *map, const char *key);
+
+// Returns the existing entry for the key, or adds a new one, with data set to NULL and count set to 0.
+// Returns NULL on memory allocation failure.
+extern struct HashMapEntry* hashmap_insert(struct HashMap *map, const char *key);
+
+// The hash used for the keys; the same value is stored in HashMapEntry.hash.
+extern size_t hashmap_hash(const char *key, int case_insensitive);
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+
+#include "src/header.h"
+#include "src/stats.h"
+
+#define RPM_STRING_TYPE        6
+#define RPM_INT32_TYPE         4
+#define RPM_STRING_ARRAY_TYPE  8
+#define RPM_I18NSTRING_TYPE    9
+
+#define ENTRY_SIZE 16
+
+// Anything larger than this is surely not a real header. Same limits as used by rpm.
+#define MAX_INDEX_COUNT 0x0000FFFF
+#define MAX_DATA_LEN    0x0FFFFFFF
+
+static uint32_t read_u32(const unsigned char *ptr) {
+	return ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) | ((uint32_t)ptr[2] << 8) | (uint32_t)ptr[3];
+}
+
+int header_init(struct Header *header, const void *blob, size_t blob_len) {
+	const unsigned char *bytes = blob;
+	if(blob_len < 8) return -1;
+
+	const uint32_t index_count = read_u32(bytes);
+	const uint32_t data_len = read_u32(bytes + 4);
+	if((index_count > MAX_INDEX_COUNT) || (data_len > MAX_DATA_LEN)) return -1;
+	if(blob_len < 8 + ((size_t)index_count * ENTRY_SIZE) + data_len) return -1;
+
+	header->index = bytes + 8;
+	header->index_count = index_count;
+	header->data = header->index + ((size_t)index_count * ENTRY_SIZE);
+	header->data_len = data_len;
+	return 0;
+}
+
+/*
+ * Only the tag field is needed to tell whether an index entry is interesting,
+ * so the rest of the entry is read only for matches. Entries are stored
+ * in data store order, not tag order, so the index can't be bisected.
+ */
+size_t header_findTags(const struct Header *header, const uint32_t *tags, struct HeaderEntry *entries, size_t count) {
+	for(size_t t = 0; t < count; ++t) entries[t].type = HEADER_TYPE_NONE;
+
+	size_t found = 0;
+	uint32_t i = 0;
+	while((i < header->index_count) && (found < count)) {
+		const unsigned char *entry = header->index + (i * ENTRY_SIZE);
+		const uint32_t tag = read_u32(entry);
+		++i;
+
+		for(size_t t = 0; t < count; ++t) {
+			if((tags[t] != tag) || (entries[t].type != HEADER_TYPE_NONE)) continue;
+
+			entries[t].type = read_u32(entry + 4);
+			entries[t].offset = read_u32(entry + 8);
+			entries[t].count = read_u32(entry + 12);
+			// RPM_NULL_TYPE entries carry no value - treat them as missing.
+			if(entries[t].type == HEADER_TYPE_NONE) break;
+
+			++found;
+			stats_add(HEADER_BYTES_READ, ENTRY_SIZE - 4);
+			break;
+		}
+	}
+	stats_add(HEADER_BYTES_READ, (unsigned long)i * 4);
+	return found;
+}
+
+const char* header_entryString(const struct Header *header, const struct HeaderEntry *entry) {
+	const uint32_t type = entry->type;
+	if((type != RPM_STRING_TYPE) && (type != RPM_STRING_ARRAY_TYPE) && (type != RPM_I18NSTRING_TYPE)) return NULL;
+	if((entry->count == 0) || (entry->offset >= header->data_len)) return NULL;
+
+	// Make sure the string is terminated before the end of the data store.
+	const char *str = (const char*)(header->data + entry->offset);
+	const char *end = memchr(str, '\0', header->data_len - entry->offset);
+	if(end == NULL) return NULL;
+
+	stats_add(HEADER_BYTES_READ, (unsigned long)(end - str) + 1);
+	return str;
+}
+
+int header_entryInt32(const struct Header *header, const struct HeaderEntry *entry, uint32_t *value) {
+	if((entry->type != RPM_INT32_TYPE) || (entry->count == 0)) return -1;
+	if((entry->offset > header->data_len) || (header->data_len - entry->offset < 4)) return -1;
+
+	stats_add(HEADER_BYTES_READ, 4);
+	*value = read_u32(header->data + entry->offset);
+	return 0;
+}
+
+int header_hasTag(const struct Header *header, uint32_t tag) {
+	struct HeaderEntry entry;
+	return header_findTags(header, &tag, &entry, 1) != 0;
+}
+
+const char* header_getString(const struct Header *header, uint32_t tag) {
+	struct HeaderEntry entry;
+	if(header_findTags(header, &tag, &entry, 1) == 0) return NULL;
+	return header_entryString(header, &entry);
+}
+
+int header_getInt32(const struct Header *header, uint32_t tag, uint32_t *value) {
+	struct HeaderEntry entry;
+	if(header_findTags(header, &tag, &entry, 1) == 0) return -1;
+	return header_entryInt32(header, &entry, value);
+}
@@ -0,0 +1,85 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_HEADER_H
+#define VRMS_RPM_HEADER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A minimal parser for rpm package headers, as stored in the rpm database.
+ * Only the few tags and data types needed by vrms-rpm are supported.
+ *
+ * The blob layout is:
+ * - number of index entries (32-bit, big-endian)
+ * - size of the data store (32-bit, big-endian)
+ * - index entries: tag, type, offset and count (each 32-bit, big-endian)
+ * - data store
+ */
+#define RPMTAG_PUBKEYS  266
+#define RPMTAG_NAME     1000
+#define RPMTAG_VERSION  1001
+#define RPMTAG_RELEASE  1002
+#define RPMTAG_EPOCH    1003
+#define RPMTAG_SUMMARY  1004
+#define RPMTAG_LICENSE  1014
+#define RPMTAG_ARCH     1022
+
+struct Header {
+	const unsigned char *index;
+	uint32_t index_count;
+	const unsigned char *data;
+	uint32_t data_len;
+};
+
+// Location of a tag's value in the data store.
+// For tags that were not found, the type is set to HEADER_TYPE_NONE.
+struct HeaderEntry {
+	uint32_t type, offset, count;
+};
+
+#define HEADER_TYPE_NONE 0
+
+// Returns 0 on success, -1 if the blob is malformed.
+// Only the blob's size is checked here; index entries are not looked at until needed.
+extern int header_init(struct Header *header, const void *blob, size_t blob_len);
+
+/*
+ * Find several tags in a single pass over the index, stopping as soon as all of them are found.
+ * The "tags" and "entries" arrays must both have "count" elements.
+ * Returns the number of tags found.
+ */
+extern size_t header_findTags(const struct Header *header, const uint32_t *tags, struct HeaderEntry *entries, size_t count);
+
+// Decode values of entries found by header_findTags(). Same rules as for the functions below.
+extern const char* header_entryString(const struct Header *header, const struct HeaderEntry *entry);
+extern int header_entryInt32(const struct Header *header, const struct HeaderEntry *entry, uint32_t *value);
+
+// Convenience functions for looking up a single tag.
+// When more than one tag is needed, prefer header_findTags(), as each call walks the index.
+
+// Check whether the header contains the given tag.
+extern int header_hasTag(const struct Header *header, uint32_t tag);
+
+// Get a string value. For string arrays and i18n strings, the first element is returned.
+// Returns NULL if the tag is missing, is of a different type, or the data is malformed.
+extern const char* header_getString(const struct Header *header, uint32_t tag);
+
+// Get the first value of an integer tag. Returns 0 on success, -1 on failure.
+extern int header_getInt32(const struct Header *header, uint32_t tag, uint32_t *value);
+
+#endif
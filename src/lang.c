@@ -16,6 +16,7 @@
  */
 #include <libintl.h>
 #include <locale.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,31 +24,58 @@
 
 #include "src/config.h"
 #include "src/lang.h"
+#include "src/stats.h"
 
 #define GENERATE_STRING(what) #what "\n",
 static const char *const msgname[] = {
 	FOREACH_MESSAGE(GENERATE_STRING)
 };
+#undef GENERATE_STRING
 
+#define MESSAGE_COUNT (sizeof(msgname) / sizeof(msgname[0]))
+
+// Translated messages, resolved on first use.
+static const char *msgtable[MESSAGE_COUNT];
+static pthread_once_t msgtable_once = PTHREAD_ONCE_INIT;
+
+static void load_translations(void) {
+	stats_begin(STATS_PHASE_LANG_INIT);
 
-void lang_init(void) {
-	setlocale(LC_ALL, "");
 	bindtextdomain("vrms-rpm", INSTALL_PREFIX "/share/locale");
 	textdomain("vrms-rpm");
 	
 	// Take a look at the test string and change locale to English
 	// if there isn't a translation available
-	const char *teststr = lang_getmsg(MSG_TRANSLATION_AUTHOR);
+	const char *teststr = gettext(msgname[MSG_TRANSLATION_AUTHOR]);
 	if(strcmp(teststr, msgname[MSG_TRANSLATION_AUTHOR]) == 0) {
 		setenv("LANGUAGE", "en", 1);
 	}
+
+	for(size_t m = 0; m < MESSAGE_COUNT; ++m) msgtable[m] = gettext(msgname[m]);
+
+	stats_end(STATS_PHASE_LANG_INIT);
+}
+
+// The locale affects more than just the messages (e.g. strcasecmp() and number formatting),
+// so it's set up front, before anything else - and, in particular, before any threads are started.
+void lang_setLocale(void) {
+	setlocale(LC_ALL, "");
+}
+
+// Loading the message catalogue is deferred until a message is actually needed,
+// so runs that never print anything translatable don't pay for it.
+// Since it may modify the environment, it must not race with other threads.
+void lang_init(void) {
+	pthread_once(&msgtable_once, load_translations);
 }
 
 char* lang_getmsg(const enum MessageID msgid) {
-	return gettext(msgname[msgid]);
+	lang_init();
+	return (char*)msgtable[msgid];
 }
 
 char* lang_getmsgn(const enum MessageID msgid, const int number) {
+	lang_init();
 	return ngettext(msgname[msgid], msgname[msgid], number);
 }
 
@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2020-2021, 2023 "suve" (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2020-2021, 2023-2024 "suve" (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -28,17 +28,32 @@
 	MESSAGE(NONFREE_PACKAGES_COUNT)  \
 	MESSAGE(RMS_HAPPY)               \
 	MESSAGE(RMS_DISAPPOINTED)        \
+	MESSAGE(SNAPSHOT_DIFF_SUMMARY)   \
+	MESSAGE(LICENCE_SUMMARY_LEAVES)  \
+	MESSAGE(LICENCE_SUMMARY_EXPRESSIONS) \
+	MESSAGE(LICENCE_LIST_COUNTS)     \
+	MESSAGE(NONFREE_THRESHOLD_REACHED) \
 	MESSAGE(HELP_USAGE)              \
+	MESSAGE(HELP_OPTION_AGGREGATE)   \
 	MESSAGE(HELP_OPTION_ASCII)       \
 	MESSAGE(HELP_OPTION_COLOUR)      \
 	MESSAGE(HELP_OPTION_DESCRIBE)    \
+	MESSAGE(HELP_OPTION_DIFFAGAINST) \
 	MESSAGE(HELP_OPTION_EVRA)        \
 	MESSAGE(HELP_OPTION_EXPLAIN)     \
+	MESSAGE(HELP_OPTION_FAILONNONFREE) \
 	MESSAGE(HELP_OPTION_GRAMMAR)     \
 	MESSAGE(HELP_OPTION_HELP)        \
 	MESSAGE(HELP_OPTION_IMAGE)       \
 	MESSAGE(HELP_OPTION_LICENCELIST) \
 	MESSAGE(HELP_OPTION_LIST)        \
+	MESSAGE(HELP_OPTION_REPODATA)    \
+	MESSAGE(HELP_OPTION_RPMDB)       \
+	MESSAGE(HELP_OPTION_RPMTIMEOUT)  \
+	MESSAGE(HELP_OPTION_SAVESNAPSHOT) \
+	MESSAGE(HELP_OPTION_STATS)       \
+	MESSAGE(HELP_OPTION_SUMMARYBYLICENCE) \
+	MESSAGE(HELP_OPTION_UNSORTED)    \
 	MESSAGE(HELP_OPTION_VERSION)     \
 	MESSAGE(ERR_MALLOC)              \
 	MESSAGE(ERR_PIPE_OPEN_FAILED)    \
@@ -46,13 +61,29 @@
 	MESSAGE(ERR_PIPE_POLL_ERROR)     \
 	MESSAGE(ERR_PIPE_POLL_HANGUP)    \
 	MESSAGE(ERR_PIPE_READ_FAILED)    \
+	MESSAGE(ERR_PIPE_CHILD_FAILED)   \
+	MESSAGE(ERR_PIPE_TIMEOUT)        \
 	MESSAGE(ERR_LICENCES_FAILED)     \
 	MESSAGE(ERR_LICENCES_BADFILE)    \
+	MESSAGE(ERR_REPODATA_OPEN_FAILED) \
+	MESSAGE(ERR_REPODATA_READ_FAILED) \
+	MESSAGE(ERR_REPODATA_UNSUPPORTED) \
+	MESSAGE(ERR_RPMDB_OPEN_FAILED)   \
+	MESSAGE(ERR_RPMDB_READ_FAILED)   \
+	MESSAGE(ERR_RPMDB_UNSUPPORTED)   \
+	MESSAGE(ERR_SNAPSHOT_READ_FAILED) \
+	MESSAGE(ERR_SNAPSHOT_WRITE_FAILED) \
+	MESSAGE(ERR_AGGREGATE_FAILED)    \
 	MESSAGE(ERR_BADOPT_COLOUR)       \
 	MESSAGE(ERR_BADOPT_EVRA)         \
+	MESSAGE(ERR_BADOPT_FAILONNONFREE) \
+	MESSAGE(ERR_BADOPT_FAILONNONFREE_CONFLICT) \
+	MESSAGE(ERR_BADOPT_RPMTIMEOUT)   \
 	MESSAGE(ERR_BADOPT_GRAMMAR)      \
 	MESSAGE(ERR_BADOPT_LIST)         \
+	MESSAGE(ERR_BADOPT_STATS)        \
 	MESSAGE(ERR_BADOPT_NOARG)        \
+	MESSAGE(ERR_BADOPT_LICENCELIST_COUNT) \
 	MESSAGE(ERR_BADOPT_UNKNOWN)      \
 
 
@@ -63,6 +94,7 @@ enum MessageID {
 #undef GENERATE_ENUM
 
 
+extern void lang_setLocale(void);
 extern void lang_init(void);
 
 extern char* lang_getmsg(const enum MessageID msgid);
@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2020-2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2020-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  * Copyright (C) 2018 Marcin "dextero" Radomski
  *
  * This program is free software: you can redistribute it and/or modify
@@ -16,15 +16,19 @@
  * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
  */
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <strings.h>
 
 #include "src/buffers.h"
+#include "src/builtin-licences.h"
 #include "src/config.h"
 #include "src/lang.h"
 #include "src/licences.h"
 #include "src/options.h"
+#include "src/spdx-index.h"
+#include "src/stats.h"
 #include "src/stringutils.h"
 
 const struct LicenceTreeNode PubkeyLicence = (struct LicenceTreeNode) {
@@ -35,7 +39,24 @@ const struct LicenceTreeNode PubkeyLicence = (struct LicenceTreeNode) {
 
 #define LIST_COUNT(data) ((data)->list->used / sizeof(char*))
 
-static FILE* openfile(char *name) {
+/*
+ * The default licence list is compiled into the executable (see generate-builtin-licences.sh),
+ * so using it requires neither file I/O, nor any memory allocations.
+ * This struct serves only as a marker - its fields are never accessed.
+ */
+static struct LicenceData builtin_data = {
+	.list = NULL,
+	.buffer = NULL,
+	.spdx = NULL,
+};
+
+/*
+ * The SPDX lists all share a single index (see generate-spdx-index.sh),
+ * with each identifier carrying a set of flags. Picking a list means picking a flag mask.
+ */
+static struct LicenceData spdx_data[SPDX_POLICY_COUNT];
+
+static FILE* openfile(const char *name) {
 	char* buffer = NULL;
 	FILE *f = NULL;
 
@@ -80,6 +101,7 @@ static struct LicenceData* licensedata_init(void) {
 
 	data->list = rebuf_init(500 * sizeof(void*));
 	data->buffer = chainbuf_init(8000);
+	data->spdx = NULL;
 
 	if((data->list == NULL) || (data->buffer == NULL)) {
 		licences_free(data);
@@ -89,11 +111,22 @@ static struct LicenceData* licensedata_init(void) {
 	return data;
 }
 
-struct LicenceData* licences_read(void) {
+struct LicenceData* licences_read(const char *name) {
+	// The bundled lists are referred to by name, while custom ones - by path.
+	// As such, a name match means we can skip reading the file.
+	if(strcmp(name, BUILTIN_LICENCE_LIST) == 0) return &builtin_data;
+
+	for(unsigned int p = 0; p < SPDX_POLICY_COUNT; ++p) {
+		if(strcmp(name, spdx_policies[p].name) == 0) {
+			spdx_data[p].spdx = &spdx_policies[p];
+			return &spdx_data[p];
+		}
+	}
+
 	struct LicenceData *result = licensedata_init();
 	if(result == NULL) return NULL;
 	
-	FILE *goodlicences = openfile(opt_licencelist);
+	FILE *goodlicences = openfile(name);
 	if(goodlicences == NULL) goto fail;
 	
 	char linebuffer[256];
@@ -120,7 +153,7 @@ struct LicenceData* licences_read(void) {
 }
 
 void licences_free(struct LicenceData *data) {
-	if(data != NULL) {
+	if((data != NULL) && (data != &builtin_data) && (data->spdx == NULL)) {
 		rebuf_free(data->list);
 		chainbuf_free(data->buffer);
 		free(data);
@@ -138,14 +171,112 @@ static int binary_search(const struct LicenceData *data, const char *const value
 	return pos;
 }
 
+static unsigned char ascii_tolower(const char c) {
+	return ((c >= 'A') && (c <= 'Z')) ? (c - 'A' + 'a') : c;
+}
+
+/*
+ * Look up the licence in the built-in list. The hash functions used here
+ * must be kept in sync with the ones in generate-builtin-licences.sh.
+ */
+static int builtin_find(const char *licence) {
+	uint32_t bucket = 2166136261u, h1 = 5381, h2 = 1;
+	for(const char *c = licence; *c != '\0'; ++c) {
+		const unsigned char lower = ascii_tolower(*c);
+		bucket = (bucket * 31) + lower;
+		h1 = (h1 * 33) + lower;
+		h2 = (h2 * 131) + lower;
+	}
+
+	const unsigned short *disp = builtin_licence_displacement[bucket % BUILTIN_LICENCE_BUCKETS];
+	const uint64_t slot = ((uint64_t)h1 + ((uint64_t)disp[0] * h2) + disp[1]) % BUILTIN_LICENCE_SLOTS;
+
+	const unsigned short index = builtin_licence_slots[slot];
+	if(index == BUILTIN_LICENCE_NO_SLOT) return -1;
+
+	// The hash is perfect only for names present in the list.
+	// Any other string can still end up pointing to an occupied slot.
+	const char *name = builtin_licence_names[index];
+	for(; *licence != '\0'; ++licence, ++name) {
+		if(ascii_tolower(*licence) != (unsigned char)*name) return -1;
+	}
+	return (*name == '\0') ? index : -1;
+}
+
+static int sorted_find(const char *const *names, const int count, const char *licence) {
+	int minpos = 0, maxpos = count - 1;
+	while(minpos <= maxpos) {
+		const int pos = (minpos + maxpos) / 2;
+		const int cmpres = strcasecmp(licence, names[pos]);
+
+		if(cmpres < 0)
+			maxpos = pos - 1;
+		else if(cmpres > 0)
+			minpos = pos + 1;
+		else
+			return pos;
+	}
+	return -1;
+}
+
+static int spdx_accepts(const struct SpdxPolicy *policy, const int pos) {
+	if(pos < 0) return 0;
+
+	const unsigned char flags = spdx_index_flags[pos] & policy->flags;
+	return policy->require_all ? (flags == policy->flags) : (flags != 0);
+}
+
 int licences_find(const struct LicenceData *data, const char *licence) {
+	stats_count(LICENCES_FIND_CALLS);
+	if(data == &builtin_data) return builtin_find(licence);
+	if(data->spdx != NULL) {
+		const int pos = sorted_find(spdx_index_names, SPDX_INDEX_COUNT, licence);
+		return spdx_accepts(data->spdx, pos) ? pos : -1;
+	}
 	return binary_search(data, licence, 0, LIST_COUNT(data)-1);
 }
 
+static unsigned int find_mask(const struct LicenceData *const *data, const unsigned int count, const char *licence) {
+	// All of the SPDX lists share the index, so the lookup needs to happen only once.
+	int spdx_pos = -1, spdx_searched = 0;
+
+	unsigned int mask = 0;
+	for(unsigned int i = 0; i < count; ++i) {
+		if(data[i]->spdx != NULL) {
+			if(!spdx_searched) {
+				stats_count(LICENCES_FIND_CALLS);
+				spdx_pos = sorted_find(spdx_index_names, SPDX_INDEX_COUNT, licence);
+				spdx_searched = 1;
+			}
+			if(spdx_accepts(data[i]->spdx, spdx_pos)) mask |= (1u << i);
+		} else if(licences_find(data[i], licence) >= 0) {
+			mask |= (1u << i);
+		}
+	}
+	return mask;
+}
+
+const char* licences_canonical(const char *licence) {
+	const int pos = sorted_find(spdx_alias_names, SPDX_ALIAS_COUNT, licence);
+	return (pos >= 0) ? spdx_alias_targets[pos] : licence;
+}
+
+unsigned int licences_findMask(const struct LicenceData *const *data, const unsigned int count, const char *licence) {
+	const unsigned int all = (1u << count) - 1;
+
+	unsigned int mask = find_mask(data, count, licence);
+	if(mask != all) {
+		// A list might only contain one spelling of the licence name - try the canonical one, too.
+		const char *canonical = licences_canonical(licence);
+		if(canonical != licence) mask |= find_mask(data, count, canonical);
+	}
+	return mask;
+}
+
 void licence_printNode(const struct LicenceTreeNode *node) {
 	if(node->type == LTNT_LICENCE) {
 		if(opt_colour)
-			printf("%s%s" ANSI_RESET, node->is_free ? ANSI_GREEN : ANSI_RED, node->licence);
+			printf("%s%s" ANSI_RESET, (node->is_free & 1) ? ANSI_GREEN : ANSI_RED, node->licence);
 		else
 			printf("%s", node->licence);
 
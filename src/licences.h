@@ -20,11 +20,30 @@
 
 #include "src/buffers.h"
 
+// Flag bits carried by identifiers in the SPDX index (see generate-spdx-index.sh).
+#define SPDX_FLAG_FSF         0x01
+#define SPDX_FLAG_OSI         0x02
+#define SPDX_FLAG_DEPRECATED  0x04
+
+// The SPDX lists are not separate files, but masks over the shared SPDX index.
+struct SpdxPolicy {
+	const char *name;
+	unsigned char flags;
+	// If set, licences must carry all of the flags; otherwise, any one is enough.
+	unsigned char require_all;
+};
+
 struct LicenceData {
 	struct ReBuffer *list;
 	struct ChainBuffer *buffer;
+	// Non-NULL for lists served from the SPDX index.
+	const struct SpdxPolicy *spdx;
 };
 
+// How many licence lists can be used at the same time.
+// Verdicts are stored as bitmasks, and the bytecode keeps them in a single byte.
+#define LICENCE_LISTS_MAX 8
+
 enum LicenceTreeNodeType {
 	LTNT_LICENCE,
 	LTNT_AND,
@@ -33,7 +52,9 @@ enum LicenceTreeNodeType {
 
 struct LicenceTreeNode {
 	enum LicenceTreeNodeType type;
-	int is_free;
+	// Bit N is set when the licence is free according to licence list N.
+	// With a single list (the usual case) this is simply 0 or 1.
+	unsigned int is_free;
 
 	union {
 		char *licence;
@@ -47,8 +68,13 @@ struct LicenceTreeNode {
 extern const struct LicenceTreeNode PubkeyLicence;
 
 
-extern struct LicenceData* licences_read(void);
+extern struct LicenceData* licences_read(const char *name);
 extern int licences_find(const struct LicenceData *data, const char *licence);
+// Look up the licence in each of the lists, returning a bitmask of the lists it was found in.
+// Legacy and deprecated names are also looked up under their canonical identifier.
+extern unsigned int licences_findMask(const struct LicenceData *const *data, unsigned int count, const char *licence);
+// Returns the canonical identifier for a licence name, or the name itself if it has no alias.
+extern const char* licences_canonical(const char *licence);
 extern void licences_free(struct LicenceData *data);
 
 
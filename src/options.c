@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018-2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  * Copyright (C) 2020 Jan Drögehoff
  *
  * This program is free software: you can redistribute it and/or modify
@@ -37,10 +37,27 @@ int opt_describe = 0;
 int opt_evra = OPT_EVRA_AUTO;
 int opt_grammar = DEFAULT_GRAMMAR_ENUM;
 int opt_explain = 0;
+int opt_failonnonfree = OPT_FAIL_NEVER;
+int opt_failthreshold = 1;
 int opt_image = OPT_IMAGE_NONE;
 int opt_list = OPT_LIST_NONFREE;
-char* opt_licencelist = DEFAULT_LICENCE_LIST;
+int opt_stats = OPT_STATS_NONE;
+int opt_summarybylicence = 0;
+int opt_unsorted = 0;
+char* opt_licencelist[LICENCE_LISTS_MAX] = { DEFAULT_LICENCE_LIST };
+int opt_licencelistcount = 1;
+char* opt_repodata = NULL;
+char* opt_rpmdb = NULL;
+int opt_rpmtimeout = 0;
+char* opt_diffagainst = NULL;
+char* opt_savesnapshot = NULL;
 
+int opt_aggregate = 0;
+char** opt_files = NULL;
+int opt_filecount = 0;
+
+// Set when --list is given explicitly, as opposed to opt_list holding the default.
+static int list_given = 0;
 
 #define ARG_NON no_argument
 #define ARG_OPT optional_argument
@@ -49,37 +66,62 @@ char* opt_licencelist = DEFAULT_LICENCE_LIST;
 enum LongOpt {
 	LONGOPT_HELP = 1,
 	LONGOPT_COLOUR,
+	LONGOPT_DIFFAGAINST,
 	LONGOPT_EVRA,
+	LONGOPT_FAILONNONFREE,
 	LONGOPT_GRAMMAR,
 	LONGOPT_LICENCELIST,
 	LONGOPT_LIST,
+	LONGOPT_REPODATA,
+	LONGOPT_RPMDB,
+	LONGOPT_RPMTIMEOUT,
+	LONGOPT_SAVESNAPSHOT,
+	LONGOPT_STATS,
 	LONGOPT_VERSION
 };
 
 static void parseopt_colour(void);
 static void parseopt_evra(void);
+static void parseopt_failonnonfree(void);
 static void parseopt_grammar(void);
 static void parseopt_list(void);
+static void parseopt_rpmtimeout(void);
+static void parseopt_stats(void);
 
 void options_parse(int argc, char **argv) {
 	const struct option vrms_opts[] = {
+		{   "aggregate", ARG_NON, &opt_aggregate, 1 },
 		{       "ascii", ARG_NON, &opt_image, OPT_IMAGE_ASCII },
 		{       "color", ARG_REQ, NULL, LONGOPT_COLOUR },
 		{      "colour", ARG_REQ, NULL, LONGOPT_COLOUR },
 		{    "describe", ARG_NON, &opt_describe, 1 },
+		{"diff-against", ARG_REQ, NULL, LONGOPT_DIFFAGAINST },
 		{        "evra", ARG_REQ, NULL, LONGOPT_EVRA },
 		{     "explain", ARG_NON, &opt_explain, 1 },
+		{"fail-on-nonfree", ARG_OPT, NULL, LONGOPT_FAILONNONFREE },
+		{"fail-on-non-free", ARG_OPT, NULL, LONGOPT_FAILONNONFREE },
 		{     "grammar", ARG_REQ, NULL, LONGOPT_GRAMMAR },
 		{        "help", ARG_NON, NULL, LONGOPT_HELP },
 		{       "image", ARG_NON, &opt_image, OPT_IMAGE_ICAT },
 		{"licence-list", ARG_REQ, NULL, LONGOPT_LICENCELIST },
 		{"license-list", ARG_REQ, NULL, LONGOPT_LICENCELIST },
 		{        "list", ARG_REQ, NULL, LONGOPT_LIST },
+		{    "repodata", ARG_REQ, NULL, LONGOPT_REPODATA },
+		{       "rpmdb", ARG_REQ, NULL, LONGOPT_RPMDB },
+		{"rpm-timeout", ARG_REQ, NULL, LONGOPT_RPMTIMEOUT },
+		{"save-snapshot", ARG_REQ, NULL, LONGOPT_SAVESNAPSHOT },
+		{       "stats", ARG_OPT, NULL, LONGOPT_STATS },
+		{"summary-by-licence", ARG_NON, &opt_summarybylicence, 1 },
+		{"summary-by-license", ARG_NON, &opt_summarybylicence, 1 },
+		{    "unsorted", ARG_NON, &opt_unsorted, 1 },
 		{     "version", ARG_NON, NULL, LONGOPT_VERSION },
 		{ 0, 0, 0, 0 },
 	};
 
 	opterr = 0;
+	// --licence-list can be repeated; the first list given replaces the default one.
+	int licencelists_given = 0;
+
 	while(1) {
 		int option_index = 0;
 		
@@ -95,21 +137,54 @@ void options_parse(int argc, char **argv) {
 				parseopt_colour();
 			break;
 
+			case LONGOPT_DIFFAGAINST:
+				opt_diffagainst = optarg;
+			break;
+
 			case LONGOPT_EVRA:
 				parseopt_evra();
 			break;
 
+			case LONGOPT_FAILONNONFREE:
+				parseopt_failonnonfree();
+			break;
+
 			case LONGOPT_GRAMMAR:
 				parseopt_grammar();
 			break;
 
 			case LONGOPT_LICENCELIST:
-				opt_licencelist = optarg;
+				if(licencelists_given == LICENCE_LISTS_MAX) {
+					lang_fprint(stderr, MSG_ERR_BADOPT_LICENCELIST_COUNT, LICENCE_LISTS_MAX);
+					exit(EXIT_FAILURE);
+				}
+				opt_licencelist[licencelists_given++] = optarg;
+				opt_licencelistcount = licencelists_given;
 			break;
 			
 			case LONGOPT_LIST:
 				parseopt_list();
 			break;
+
+			case LONGOPT_REPODATA:
+				opt_repodata = optarg;
+			break;
+
+			case LONGOPT_RPMDB:
+				opt_rpmdb = optarg;
+			break;
+
+			case LONGOPT_RPMTIMEOUT:
+				parseopt_rpmtimeout();
+			break;
+
+			case LONGOPT_SAVESNAPSHOT:
+				opt_savesnapshot = optarg;
+			break;
+
+			case LONGOPT_STATS:
+				parseopt_stats();
+			break;
 			
 			case LONGOPT_VERSION:
 				puts("vrms-rpm v2.3 by suve");
@@ -129,6 +204,35 @@ void options_parse(int argc, char **argv) {
 		}
 	}
 	
+	// Positional arguments are only used as the list of snapshots to aggregate.
+	opt_files = argv + optind;
+	opt_filecount = argc - optind;
+	if((opt_filecount > 0) && !opt_aggregate) {
+		lang_fprint(stderr, MSG_ERR_BADOPT_UNKNOWN, opt_files[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	// The gate mode keeps no package list around, so there's nothing to compare, save or list.
+	if(opt_failonnonfree != OPT_FAIL_NEVER) {
+		const char *conflict = NULL;
+		if(opt_diffagainst != NULL)
+			conflict = "--diff-against";
+		else if(opt_savesnapshot != NULL)
+			conflict = "--save-snapshot";
+		else if(list_given && (opt_list != 0))
+			conflict = "--list";
+		else if(opt_summarybylicence)
+			conflict = "--summary-by-licence";
+
+		if(conflict != NULL) {
+			lang_fprint(stderr, MSG_ERR_BADOPT_FAILONNONFREE_CONFLICT, conflict);
+			exit(EXIT_FAILURE);
+		}
+
+		// Only the counts are printed, so the default of listing non-free packages doesn't apply.
+		opt_list = 0;
+	}
+
 	if(opt_colour == OPT_COLOUR_AUTO) {
 		if (getenv("NO_COLOR") != NULL) {
 			opt_colour = OPT_COLOUR_NEVER;
@@ -169,6 +273,26 @@ static void parseopt_evra(void) {
 	}
 }
 
+// The threshold can be given either as a number of packages, or as a percentage of all packages.
+static void parseopt_failonnonfree(void) {
+	if(optarg == NULL) {
+		opt_failonnonfree = OPT_FAIL_COUNT;
+		opt_failthreshold = 1;
+		return;
+	}
+
+	char *endptr;
+	const long value = strtol(optarg, &endptr, 10);
+	const int is_percent = (*endptr == '%') && (endptr[1] == '\0');
+	if((endptr == optarg) || ((*endptr != '\0') && !is_percent) || (value < 1) || (value > (is_percent ? 100 : 1000000))) {
+		lang_fprint(stderr, MSG_ERR_BADOPT_FAILONNONFREE);
+		exit(EXIT_FAILURE);
+	}
+
+	opt_failonnonfree = is_percent ? OPT_FAIL_PERCENT : OPT_FAIL_COUNT;
+	opt_failthreshold = value;
+}
+
 static void parseopt_grammar(void) {
 	if(arg_eq("loose")) {
 		opt_grammar = OPT_GRAMMAR_LOOSE;
@@ -183,6 +307,7 @@ static void parseopt_grammar(void) {
 }
 
 static void parseopt_list(void) {
+	list_given = 1;
 	if(arg_eq("all")) {
 		opt_list = OPT_LIST_FREE | OPT_LIST_NONFREE;
 	} else if(arg_eq("free")) {
@@ -197,9 +322,33 @@ static void parseopt_list(void) {
 	}
 }
 
+static void parseopt_rpmtimeout(void) {
+	char *endptr;
+	const long value = strtol(optarg, &endptr, 10);
+	if((endptr == optarg) || (*endptr != '\0') || (value < 0) || (value > 86400)) {
+		lang_fprint(stderr, MSG_ERR_BADOPT_RPMTIMEOUT);
+		exit(EXIT_FAILURE);
+	}
+	opt_rpmtimeout = value;
+}
+
+static void parseopt_stats(void) {
+	if((optarg == NULL) || arg_eq("text")) {
+		opt_stats = OPT_STATS_TEXT;
+	} else if(arg_eq("json")) {
+		opt_stats = OPT_STATS_JSON;
+	} else {
+		lang_fprint(stderr, MSG_ERR_BADOPT_STATS);
+		exit(EXIT_FAILURE);
+	}
+}
+
 static void print_help(void) {
 	lang_print(MSG_HELP_USAGE);
 	
+	puts("  --aggregate [FILE...]");
+	lang_print(MSG_HELP_OPTION_AGGREGATE);
+	
 	puts("  --ascii");
 	lang_print(MSG_HELP_OPTION_ASCII);
 	
@@ -209,12 +358,18 @@ static void print_help(void) {
 	puts("  --describe");
 	lang_print(MSG_HELP_OPTION_DESCRIBE);
 	
+	puts("  --diff-against <FILE>");
+	lang_print(MSG_HELP_OPTION_DIFFAGAINST);
+
 	puts("  --evra <auto, never, always>");
 	lang_print(MSG_HELP_OPTION_EVRA);
 
 	puts("  --explain");
 	lang_print(MSG_HELP_OPTION_EXPLAIN);
 
+	puts("  --fail-on-nonfree[=<COUNT, PERCENT%>]");
+	lang_print(MSG_HELP_OPTION_FAILONNONFREE);
+
 	puts("  --grammar <loose, spdx-strict, spdx-lenient>");
 	lang_print(MSG_HELP_OPTION_GRAMMAR, DEFAULT_GRAMMAR_NAME);
 
@@ -230,6 +385,27 @@ static void print_help(void) {
 	puts("  --list <none, free, nonfree, all>");
 	lang_print(MSG_HELP_OPTION_LIST);
 	
+	puts("  --repodata <FILE>");
+	lang_print(MSG_HELP_OPTION_REPODATA);
+	
+	puts("  --rpmdb <FILE>");
+	lang_print(MSG_HELP_OPTION_RPMDB);
+	
+	puts("  --rpm-timeout <SECONDS>");
+	lang_print(MSG_HELP_OPTION_RPMTIMEOUT);
+
+	puts("  --save-snapshot <FILE>");
+	lang_print(MSG_HELP_OPTION_SAVESNAPSHOT);
+	
+	puts("  --stats[=<text, json>]");
+	lang_print(MSG_HELP_OPTION_STATS);
+	
+	puts("  --summary-by-licence");
+	lang_print(MSG_HELP_OPTION_SUMMARYBYLICENCE);
+	
+	puts("  --unsorted");
+	lang_print(MSG_HELP_OPTION_UNSORTED);
+	
 	puts("  --version");
 	lang_print(MSG_HELP_OPTION_VERSION);
 }
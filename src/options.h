@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2020-2021, 2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2020-2021, 2023-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -18,6 +18,8 @@
 #ifndef VRMS_RPM_OPTIONS_H
 #define VRMS_RPM_OPTIONS_H
 
+#include "src/licences.h"
+
 #define OPT_EVRA_NEVER  -1
 #define OPT_EVRA_AUTO    0
 #define OPT_EVRA_ALWAYS +1
@@ -33,14 +35,37 @@
 #define OPT_LIST_FREE    (1<<0)
 #define OPT_LIST_NONFREE (1<<1)
 
+#define OPT_FAIL_NEVER   0
+#define OPT_FAIL_COUNT   1
+#define OPT_FAIL_PERCENT 2
+
+#define OPT_STATS_NONE 0
+#define OPT_STATS_TEXT 1
+#define OPT_STATS_JSON 2
+
 extern int opt_colour;
 extern int opt_describe;
 extern int opt_evra;
 extern int opt_explain;
+extern int opt_failonnonfree;
+extern int opt_failthreshold;
 extern int opt_grammar;
 extern int opt_image;
 extern int opt_list;
-extern char* opt_licencelist;
+extern int opt_stats;
+extern int opt_summarybylicence;
+extern int opt_unsorted;
+extern char* opt_licencelist[LICENCE_LISTS_MAX];
+extern int opt_licencelistcount;
+extern char* opt_repodata;
+extern char* opt_rpmdb;
+extern int opt_rpmtimeout;
+extern char* opt_diffagainst;
+extern char* opt_savesnapshot;
+
+extern int opt_aggregate;
+extern char** opt_files;
+extern int opt_filecount;
 
 extern void options_parse(int argc, char **argv);
 
@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2021-2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2021-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -18,13 +18,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <unistd.h>
 
 #include "src/buffers.h"
+#include "src/bytecode.h"
+#include "src/hashmap.h"
 #include "src/lang.h"
 #include "src/licences.h"
 #include "src/options.h"
 #include "src/packages.h"
 #include "src/pipes.h"
+#include "src/snapshot.h"
+#include "src/sort.h"
+#include "src/stats.h"
 #include "src/stringutils.h"
 #include "src/versions.h"
 
@@ -33,6 +39,12 @@
 	"\\t%|PUBKEYS?{1}:{0}|" \
 	"\\t%{LICENSE}" \
 
+#define RPM_BINARY "/usr/bin/rpm"
+
+int packages_canOpenPipe(void) {
+	return access(RPM_BINARY, X_OK) == 0;
+}
+
 struct Pipe* packages_openPipe(void) {
 	char *queryformat;
 	if(!opt_describe)
@@ -41,7 +53,7 @@ struct Pipe* packages_openPipe(void) {
 		queryformat = QUERY_BASE "\\t%{SUMMARY}\\n";
 
 	char *args[] = {
-		"/usr/bin/rpm",
+		RPM_BINARY,
 		"--all",
 		"--query",
 		"--queryformat",
@@ -49,38 +61,160 @@ struct Pipe* packages_openPipe(void) {
 		(char*)NULL
 	};
 
-	return pipe_create(args);
+	return pipe_create(args, opt_rpmtimeout);
 }
 
 
 struct Package {
 	char *name, *summary;
 	char *epoch, *release, *version, *arch;
-	struct LicenceTreeNode *licence;
+	const unsigned char *evr; // Tokenised epoch, version and release, used for sorting; see TOKENISE_EVRS
+	const unsigned char *licence_code; // Only kept for --explain; see bytecode.h
+	const char *licence_string; // As read from the package
+	int is_free;
 	int is_pubkey;
+	size_t index; // Position in rpm output, used as the last-resort tie-breaker when sorting
 };
 
-#define LIST_COUNT      (list->used / sizeof(struct Package))
-#define LIST_ITEM(idx)  ( ((struct Package*)list->data)[(idx)] )
-static struct ReBuffer *list = NULL;
+// Non-free [0] and free [1] packages are kept in separate tables,
+// so a class that is not going to be listed doesn't have to be stored or sorted.
+#define LIST_COUNT(kind)      ((list[(kind)] != NULL) ? (list[(kind)]->used / sizeof(struct Package)) : 0)
+#define LIST_ITEM(kind, idx)  ( ((struct Package*)list[(kind)]->data)[(idx)] )
+static struct ReBuffer *list[2] = { NULL, NULL };
 static struct ChainBuffer *buffer = NULL;
 
-static int class_count[2] = {0, 0};
+// For packages that are not stored, only a hash of their (case-folded) name is kept,
+// so --evra auto can still tell whether a listed package's name is a duplicate.
+static struct ReBuffer *nameHashes = NULL;
+
+// Scratch space for packages_add(), allocated together with the buffers above.
+#define LINEBUF_SIZE 4096
+#define LICBUF_SIZE  LINEBUF_SIZE
+#define EVRBUF_SIZE  TOKENISED_EVR_MAX_SIZE(0, LINEBUF_SIZE, 0)
+#define EVR_MAX_LEN  LINEBUF_SIZE
+
+// When built with librpm, EVRs are compared using rpm's own rpmvercmp(), which works on the strings.
+// Otherwise, they're tokenised once when reading the package list, so sorting doesn't have to re-parse them.
+#ifdef WITH_LIBRPM
+	#define TOKENISE_EVRS 0
+#else
+	#define TOKENISE_EVRS 1
+#endif
+static char *licenceBuffer = NULL;
+static char *treeBuffer = NULL;
+static unsigned char *evrBuffer = NULL;
+static struct ReBuffer *codeBuffer = NULL;
+
+// Number of non-free [0] and free [1] packages, according to each of the licence lists.
+// The first list is the one deciding which packages get listed.
+static int class_count[LICENCE_LISTS_MAX][2];
 static int sorted = 0;
 
+// Histograms for --summary-by-licence: how many packages use each leaf licence,
+// and each full licence expression. Leaf keys are canonical names, so different spellings
+// of the same licence are counted together. Keys are copied when first seen, so the histograms
+// grow with the number of distinct licences, not with the number of packages.
+struct LicenceCount {
+	size_t packages;
+	size_t last_package; // Count a leaf only once, even if it appears many times in an expression
+	int is_free;
+};
+static struct HashMap *leafCounts = NULL;
+static struct HashMap *expressionCounts = NULL;
+
+
+/*
+ * Decide whether packages of the given class need to be stored. If nothing is going
+ * to look at them afterwards (they're not listed, there's no snapshot to save or diff against),
+ * they're just counted and forgotten, so memory usage doesn't grow with their number.
+ */
+static int keep_class(const int is_free) {
+	// Snapshots always hold all of the packages.
+	if((opt_diffagainst != NULL) || (opt_savesnapshot != NULL)) return 1;
+	return (opt_list & (is_free ? OPT_LIST_FREE : OPT_LIST_NONFREE)) != 0;
+}
 
 static int init_buffers(void) {
-	if(list == NULL) {
-		list = rebuf_init(1024 * sizeof(void*));
-		if(list == NULL) return -1;
+	for(int kind = 0; kind < 2; ++kind) {
+		if(keep_class(kind) && (list[kind] == NULL)) {
+			list[kind] = rebuf_init(1024 * sizeof(void*));
+			if(list[kind] == NULL) return -1;
+		}
+	}
+	if((opt_list != 0) && (opt_evra == OPT_EVRA_AUTO) && (nameHashes == NULL)) {
+		nameHashes = rebuf_init(1024 * sizeof(size_t));
+		if(nameHashes == NULL) return -1;
 	}
 	if(buffer == NULL) {
 		buffer = chainbuf_init(16256);
 		if(buffer == NULL) return -1;
 	}
+	if(licenceBuffer == NULL) {
+		licenceBuffer = malloc(LICBUF_SIZE);
+		if(licenceBuffer == NULL) return -1;
+	}
+	if(treeBuffer == NULL) {
+		treeBuffer = malloc(LICBUF_SIZE);
+		if(treeBuffer == NULL) return -1;
+	}
+	if(evrBuffer == NULL) {
+		evrBuffer = malloc(EVRBUF_SIZE);
+		if(evrBuffer == NULL) return -1;
+	}
+	if(codeBuffer == NULL) {
+		codeBuffer = rebuf_init(1024);
+		if(codeBuffer == NULL) return -1;
+	}
+	if(opt_summarybylicence && (leafCounts == NULL)) {
+		leafCounts = hashmap_init(0, 0);
+		if(leafCounts == NULL) return -1;
+	}
+	if(opt_summarybylicence && (expressionCounts == NULL)) {
+		expressionCounts = hashmap_init(0, 0);
+		if(expressionCounts == NULL) return -1;
+	}
+	return 0;
+}
+
+// Returns the counter for the key, adding it to the map if needed.
+static struct LicenceCount* licence_counter(struct HashMap *map, const char *key) {
+	struct HashMapEntry *entry = hashmap_find(map, key);
+	if(entry != NULL) return entry->data;
+
+	const char *key_copy = chainbuf_append(&buffer, key);
+	if(key_copy == NULL) return NULL;
+
+	entry = hashmap_insert(map, key_copy);
+	if(entry == NULL) return NULL;
+
+	const struct LicenceCount empty = { .last_package = (size_t)-1 };
+	entry->data = chainbuf_appendAligned(&buffer, &empty, sizeof(empty));
+	return entry->data;
+}
+
+static int count_leaves(const struct LicenceTreeNode *node, size_t package) {
+	if(node->type != LTNT_LICENCE) {
+		for(unsigned int m = 0; m < node->members; ++m) {
+			if(count_leaves(node->child[m], package) != 0) return -1;
+		}
+		return 0;
+	}
+
+	struct LicenceCount *counter = licence_counter(leafCounts, licences_canonical(node->licence));
+	if(counter == NULL) return -1;
+
+	if(counter->last_package != package) {
+		counter->last_package = package;
+		counter->packages += 1;
+		counter->is_free = node->is_free & 1;
+	}
 	return 0;
 }
 
+// Timing individual lines adds a few syscalls per package, so only do it when asked to.
+#define DETAILED_STATS_BEGIN(phase)  do { if(opt_stats) stats_begin(STATS_PHASE_ ## phase); } while(0)
+#define DETAILED_STATS_END(phase)    do { if(opt_stats) stats_end(STATS_PHASE_ ## phase); } while(0)
+
 static int is_defined(const char *value) {
 	return strcmp(value, "(none)") != 0;
 }
@@ -90,95 +224,214 @@ static int is_defined(const char *value) {
  * in which RPM stores imported GPG keys. These are a special case
  * and should be treated as such.
  */
-static int is_pubkey_package(const char *name, const char *arch, const char *pubkeys, const char *licence) {
+int packages_isPubkey(const char *name, const char *arch, int has_pubkeys, const char *licence) {
 	// Check arch first before engaging in expensive strcmp() calls.
 	return
 		(arch == NULL) &&
-		(strcmp(pubkeys, "1") == 0) &&
+		has_pubkeys &&
 		(strcmp(name, "gpg-pubkey") == 0) &&
 		(strcmp(licence, "pubkey") == 0);
 }
 
 int packages_read(struct Pipe *pipe, struct LicenceClassifier *classifier) {
-	char *line = NULL;
-	char *licenceBuffer = NULL;
-	FILE *f = NULL;
+	DETAILED_STATS_BEGIN(READ_WAIT);
+	FILE *f = pipe_fopen(pipe);
+	DETAILED_STATS_END(READ_WAIT);
+	if(f == NULL) return -1;
+
+	const int result = packages_readFile(f, classifier);
+	// If we stopped early, rpm would keep on going until it fills up the pipe.
+	if(packages_shouldStop()) pipe_terminate(pipe);
+	fclose(f);
+	return result;
+}
 
-	#define LINEBUF_SIZE 4096
-	line = malloc(LINEBUF_SIZE);
-	if(line == NULL) goto fail;
+static size_t package_count(void) {
+	return (size_t)class_count[0][0] + (size_t)class_count[0][1];
+}
 
-	#define LICBUF_SIZE LINEBUF_SIZE
-	licenceBuffer = malloc(LICBUF_SIZE);
-	if(licenceBuffer == NULL) goto fail;
+int packages_shouldStop(void) {
+	// With a percentage, the verdict can't be known until all of the packages have been read.
+	return (opt_failonnonfree == OPT_FAIL_COUNT) && (class_count[0][0] >= opt_failthreshold);
+}
 
-	if(init_buffers() != 0) goto fail;
+// Copy the package's data into the buffers and add it to the table for its class.
+// The (balanced) licence string is expected to be in licenceBuffer.
+static int store_package(struct PackageInfo *info, const int is_free, const unsigned char *licence_code) {
+	DETAILED_STATS_BEGIN(READ_PARSE);
+	char *licence_string = chainbuf_append(&buffer, licenceBuffer);
+	char *name = chainbuf_append(&buffer, trim(info->name, NULL));
+	char *summary = opt_describe ? chainbuf_append(&buffer, trim(info->summary, NULL)) : NULL;
+
+	char *epoch = (info->epoch != NULL) ? chainbuf_append(&buffer, info->epoch) : NULL;
+	char *arch = (info->arch != NULL) ? chainbuf_append(&buffer, info->arch) : NULL;
+	char *version = chainbuf_append(&buffer, info->version);
+	char *release = chainbuf_append(&buffer, info->release);
+
+	// Tokenise the EVR once here, instead of every time the package is compared.
+	const unsigned char *evr = NULL;
+	if(TOKENISE_EVRS && (version != NULL) && (release != NULL)) {
+		const size_t evr_len = versions_tokenise(epoch, version, release, evrBuffer, EVRBUF_SIZE);
+		evr = (evr_len != 0) ? chainbuf_appendData(&buffer, evrBuffer, evr_len) : NULL;
+	}
+	DETAILED_STATS_END(READ_PARSE);
+
+	// Any of the copies failing means the buffer could not grow.
+	if((licence_string == NULL) || (name == NULL) || (version == NULL) || (release == NULL)) return -1;
+	if(opt_describe && (summary == NULL)) return -1;
+	if(((info->epoch != NULL) && (epoch == NULL)) || ((info->arch != NULL) && (arch == NULL))) return -1;
+	if(TOKENISE_EVRS && (evr == NULL)) return -1;
+
+	struct Package pkg = {
+		.name = name,
+		.summary = summary,
+		.epoch = epoch,
+		.version = version,
+		.release = release,
+		.arch = arch,
+		.evr = evr,
+		.licence_code = licence_code,
+		.licence_string = licence_string,
+		.is_free = is_free,
+		.is_pubkey = info->is_pubkey,
+		.index = package_count(),
+	};
+	if(rebuf_append(list[is_free], &pkg, sizeof(struct Package)) == NULL) return -1;
 
-	f = pipe_fopen(pipe);
-	if(f == NULL) goto fail;
+	sorted = 0;
+	return 0;
+}
+
+static int remember_name(const char *name) {
+	if(nameHashes == NULL) return 0;
+
+	const size_t hash = hashmap_hash(name, 1);
+	return (rebuf_append(nameHashes, &hash, sizeof(hash)) != NULL) ? 0 : -1;
+}
+
+int packages_add(struct PackageInfo *info, struct LicenceClassifier *classifier) {
+	if(init_buffers() != 0) return -1;
+
+	// The EVR is tokenised into a fixed-size scratch buffer when the package is stored.
+	// A package with a (bogus) longer one is skipped, just like a malformed line would be.
+	const size_t evr_len = ((info->epoch != NULL) ? strlen(info->epoch) : 0) + strlen(info->version) + strlen(info->release);
+	if(evr_len > EVR_MAX_LEN) {
+		stats_count(LINES_REJECTED);
+		return 0;
+	}
+
+	// FIXME: This function can fail, should handle that somehow
+	DETAILED_STATS_BEGIN(READ_PARSE);
+	str_balance_parentheses(trim(info->licence, NULL), licenceBuffer, LICBUF_SIZE, NULL);
+	DETAILED_STATS_END(READ_PARSE);
+
+	// The classifier modifies its input, so it works on a copy - the original string
+	// is still needed if the package ends up being stored.
+	DETAILED_STATS_BEGIN(READ_CLASSIFY);
+	char *tree_licence = strcpy(treeBuffer, licenceBuffer);
+
+	// Unless something is going to look at the licence tree, only the verdict is computed.
+	const int need_tree = opt_explain || opt_summarybylicence;
+	struct LicenceTreeNode pubkey = PubkeyLicence;
+	struct LicenceTreeNode *classification = NULL;
+	unsigned int verdict; // One bit per licence list
+	if(info->is_pubkey) {
+		// Point the leaf at the package's own string, so it can be encoded like any other.
+		// Pubkeys are considered free no matter the list.
+		pubkey.licence = tree_licence;
+		pubkey.is_free = (1u << opt_licencelistcount) - 1;
+		if(need_tree) classification = &pubkey;
+		verdict = pubkey.is_free;
+	} else if(need_tree) {
+		stats_count(CLASSIFIER_CALLS);
+		classification = classifier->classify(classifier, tree_licence);
+		if(classification == NULL) return -1;
+		verdict = classification->is_free;
+	} else {
+		stats_count(CLASSIFIER_CALLS);
+		verdict = classifier->evaluate(classifier, tree_licence);
+	}
+	const int is_free = verdict & 1;
+	const int keep = keep_class(is_free);
+
+	if(opt_summarybylicence) {
+		struct LicenceCount *expression = licence_counter(expressionCounts, licenceBuffer);
+		if((expression == NULL) || (count_leaves(classification, package_count()) != 0)) {
+			if(!info->is_pubkey) licence_freeTree(classification);
+			return -1;
+		}
+		expression->packages += 1;
+		expression->is_free = is_free;
+	}
+
+	// The tree itself is not kept - only its compact encoding, for --explain.
+	const unsigned char *licence_code = NULL;
+	if(keep && opt_explain) {
+		codeBuffer->used = 0;
+		if(bytecode_encode(classification, tree_licence, codeBuffer) == 0) {
+			licence_code = chainbuf_appendData(&buffer, codeBuffer->data, codeBuffer->used);
+		}
+	}
+	if(!info->is_pubkey) licence_freeTree(classification);
+	DETAILED_STATS_END(READ_CLASSIFY);
+	if(keep && opt_explain && (licence_code == NULL)) return -1;
+
+	const int result = keep ? store_package(info, is_free, licence_code) : remember_name(trim(info->name, NULL));
+	if(result != 0) return -1;
+
+	for(int i = 0; i < opt_licencelistcount; ++i) class_count[i][(verdict >> i) & 1] += 1;
+	return 0;
+}
+
+int packages_readFile(FILE *f, struct LicenceClassifier *classifier) {
+	char *line = malloc(LINEBUF_SIZE);
+	if(line == NULL) goto fail;
+
+	if(init_buffers() != 0) goto fail;
 
 	const int expected = opt_describe ? 8 : 7;
 	char* fields[8];
 
-	while(fgets(line, LINEBUF_SIZE, f) != NULL) {
-		replace_unicode_spaces(line);
-		str_squeeze_char(line, ' ');
-		if(str_split(line, '\t', fields, expected) != expected) continue;
-
-		char *name    = fields[0];
-		char *epoch   = fields[1];
-		char *version = fields[2];
-		char *release = fields[3];
-		char *arch    = fields[4];
-		char *pubkeys = fields[5];
-		char *licence = fields[6];
-		char *summary = fields[7];
+	while(1) {
+		DETAILED_STATS_BEGIN(READ_WAIT);
+		char *got = fgets(line, LINEBUF_SIZE, f);
+		DETAILED_STATS_END(READ_WAIT);
+		if(got == NULL) break;
 
-		// FIXME: This function can fail, should handle that somehow
-		str_balance_parentheses(trim(licence, NULL), licenceBuffer, LICBUF_SIZE, NULL);
-		licence = chainbuf_append(&buffer, licenceBuffer);
+		stats_count(LINES_READ);
+		DETAILED_STATS_BEGIN(READ_PARSE);
 
-		name = chainbuf_append(&buffer, trim(name, NULL));
-		if(opt_describe) summary = chainbuf_append(&buffer, trim(summary, NULL));
+		replace_unicode_spaces(line);
+		str_squeeze_char(line, ' ');
+		if(str_split(line, '\t', fields, expected) != expected) {
+			stats_count(LINES_REJECTED);
+			DETAILED_STATS_END(READ_PARSE);
+			continue;
+		}
 
 		// Epoch is typically undefined. RPM reports this using the special string "(none)".
 		// Avoid storing unnecessary epoch info by comparing epoch with this special string.
 		// In some very rare cases (hello, "gpg-pubkey" packages!), this can also happen to Arch.
-		epoch = is_defined(epoch) ? chainbuf_append(&buffer, epoch) : NULL;
-		arch = is_defined(arch) ? chainbuf_append(&buffer, arch) : NULL;
-
-		version = chainbuf_append(&buffer, version);
-		release = chainbuf_append(&buffer, release);
-
-		const int is_pubkey = is_pubkey_package(name, arch, pubkeys, licence);
-		struct LicenceTreeNode *classification = is_pubkey
-				? ((struct LicenceTreeNode*)(&PubkeyLicence))
-				: classifier->classify(classifier, licence);
-		class_count[classification->is_free] += 1;
-
-		struct Package pkg = {
-			.name = name,
-			.summary = summary,
-			.epoch = epoch,
-			.version = version,
-			.release = release,
-			.arch = arch,
-			.licence = classification,
-			.is_pubkey = is_pubkey,
+		struct PackageInfo info = {
+			.name    = trim(fields[0], NULL),
+			.epoch   = is_defined(fields[1]) ? fields[1] : NULL,
+			.version = fields[2],
+			.release = fields[3],
+			.arch    = is_defined(fields[4]) ? fields[4] : NULL,
+			.licence = trim(fields[6], NULL),
+			.summary = fields[7],
 		};
-		if(rebuf_append(list, &pkg, sizeof(struct Package)) == NULL) goto fail;
+		info.is_pubkey = packages_isPubkey(info.name, info.arch, strcmp(fields[5], "1") == 0, info.licence);
+		DETAILED_STATS_END(READ_PARSE);
+
+		if(packages_add(&info, classifier) != 0) goto fail;
+		if(packages_shouldStop()) break;
 	}
 
-	fclose(f);
-	free(licenceBuffer);
 	free(line);
-
-	sorted = 0;
-	return LIST_COUNT;
+	return (int)package_count();
 
 	fail: { // As seen in CVE-2014-1266!
-		if(f != NULL) fclose(f);
-		if(licenceBuffer != NULL) free(licenceBuffer);
 		if(line != NULL) free(line);
 		packages_free();
 		return -1;
@@ -186,68 +439,134 @@ int packages_read(struct Pipe *pipe, struct LicenceClassifier *classifier) {
 }
 
 void packages_free(void) {
-	if(list != NULL) {
-		const int count = LIST_COUNT;
-		for(int i = 0; i < count; ++i) {
-			struct Package *pkg = &LIST_ITEM(i);
-			if(!pkg->is_pubkey) licence_freeTree(pkg->licence);
+	for(int kind = 0; kind < 2; ++kind) {
+		if(list[kind] != NULL) {
+			rebuf_free(list[kind]);
+			list[kind] = NULL;
 		}
-		
-		rebuf_free(list);
-		list = NULL;
+	}
+	if(nameHashes != NULL) {
+		rebuf_free(nameHashes);
+		nameHashes = NULL;
 	}
 	
 	if(buffer != NULL) {
 		chainbuf_free(buffer);
 		buffer = NULL;
 	}
+
+	free(licenceBuffer);
+	licenceBuffer = NULL;
+	free(treeBuffer);
+	treeBuffer = NULL;
+	free(evrBuffer);
+	evrBuffer = NULL;
+	rebuf_free(codeBuffer);
+	codeBuffer = NULL;
+
+	hashmap_free(leafCounts);
+	leafCounts = NULL;
+	hashmap_free(expressionCounts);
+	expressionCounts = NULL;
 	
-	class_count[0] = class_count[1] = 0;
+	memset(class_count, 0, sizeof(class_count));
 }
 
-static int pkgcompare(const void *A, const void *B) {
-	const struct Package *a = A;
-	const struct Package *b = B;
-	
+// The fields compare_nevra() looks at. Both packages and snapshot entries have them,
+// so either can be turned into a key with NEVRA_KEY().
+struct NevraKey {
+	const char *name, *epoch, *version, *release, *arch;
+	const unsigned char *evr;
+};
+#define NEVRA_KEY(item)  (&(const struct NevraKey){ (item)->name, (item)->epoch, (item)->version, (item)->release, (item)->arch, (item)->evr })
+
+// Compare two packages by name, EVR and arch. Shared between sorting and snapshot diffing,
+// so the merge-join in packages_diffSnapshot() sees the same order as packages_sort() produces.
+static int compare_nevra(const struct NevraKey *a, const struct NevraKey *b) {
 	int compare_names = strcasecmp(a->name, b->name);
 	if(compare_names) return compare_names;
 
-	// Compare the Epoch, Version, and Release tags of the packages,
-	// using the fancy librpm algorithm (or our fallback).
-	const char* pairs[] = {
-		a->epoch, b->epoch,
-		a->version, b->version,
-		a->release, b->release,
-	};
-	for(unsigned int p = 0; p < sizeof(pairs) / sizeof(pairs[0]) / 2; ++p) {
-		const char *pair_a = pairs[p*2];
-		const char *pair_b = pairs[p*2 + 1];
-		
-		int compare_pair = compare_versions(pair_a, pair_b);
-		if(compare_pair) return compare_pair;
+	// Compare the Epoch, Version, and Release tags of the packages, using the fancy
+	// librpm algorithm, or the tokens prepared when reading the package list.
+	if(TOKENISE_EVRS) {
+		int compare_evr = versions_compareTokens(a->evr, b->evr);
+		if(compare_evr) return compare_evr;
+	} else {
+		const char* pairs[] = {
+			a->epoch, b->epoch,
+			a->version, b->version,
+			a->release, b->release,
+		};
+		for(unsigned int p = 0; p < sizeof(pairs) / sizeof(pairs[0]) / 2; ++p) {
+			int compare_pair = compare_versions(pairs[p*2], pairs[p*2 + 1]);
+			if(compare_pair) return compare_pair;
+		}
 	}
 
 	// If EVRs are deemed to be equal, resort to comparing Arch.
 	return str_compare_with_null_check(a->arch, b->arch, &strcmp);
 }
 
-static void packages_sort(void) {
-	qsort(list->data, LIST_COUNT, sizeof(struct Package), &pkgcompare);
+static int pkgcompare(const void *A, const void *B) {
+	const struct Package *a = A;
+	const struct Package *b = B;
+
+	int compare_keys = compare_nevra(NEVRA_KEY(a), NEVRA_KEY(b));
+	if(compare_keys) return compare_keys;
+
+	// The same package can be listed twice, e.g. when the rpmdb is in a bad state.
+	// Keep the original order, so the result does not depend on the sorting algorithm.
+	return (a->index > b->index) - (a->index < b->index);
+}
+
+// Below this many packages, starting up threads costs more than it saves.
+#define PARALLEL_SORT_THRESHOLD 65536
+
+void packages_sort(void) {
+	if(sorted) return;
+
+	for(int kind = 0; kind < 2; ++kind) {
+		const size_t count = LIST_COUNT(kind);
+		if(count >= PARALLEL_SORT_THRESHOLD)
+			sort_parallel(list[kind]->data, count, sizeof(struct Package), &pkgcompare, sort_threadCount());
+		else if(count > 1)
+			qsort(list[kind]->data, count, sizeof(struct Package), &pkgcompare);
+	}
 	sorted = 1;
 }
 
-static void print_evra(const struct Package *pkg) {
+/*
+ * Walk both (sorted) tables side by side, returning the packages in the same order
+ * a single sorted table would have. Returns NULL once both tables are exhausted.
+ */
+static const struct Package* next_package(size_t position[2]) {
+	const int has_nonfree = position[0] < LIST_COUNT(0);
+	const int has_free = position[1] < LIST_COUNT(1);
+	if(!has_nonfree && !has_free) return NULL;
+
+	int kind = has_free;
+	if(has_nonfree && has_free) {
+		kind = pkgcompare(&LIST_ITEM(0, position[0]), &LIST_ITEM(1, position[1])) > 0;
+	}
+	return &LIST_ITEM(kind, position[kind]++);
+}
+
+static void print_evra_fields(const char *epoch, const char *version, const char *release, const char *arch) {
 	printf(
 		"-%s%s%s-%s%s%s",
-		(pkg->epoch != NULL) ? pkg->epoch : "",
-		(pkg->epoch != NULL) ? ":" : "",
-		pkg->version,
-		pkg->release,
-		(pkg->arch != NULL) ? "." : "",
-		(pkg->arch != NULL) ? pkg->arch : ""
+		(epoch != NULL) ? epoch : "",
+		(epoch != NULL) ? ":" : "",
+		version,
+		release,
+		(arch != NULL) ? "." : "",
+		(arch != NULL) ? arch : ""
 	);
 }
 
+static void print_evra(const struct Package *pkg) {
+	print_evra_fields(pkg->epoch, pkg->version, pkg->release, pkg->arch);
+}
+
 /*
  * Decide whether to print the epoch:version-release.arch information,
  * to eliminate ambiguity as to which package we're describing.
@@ -269,72 +588,275 @@ static void print_evra(const struct Package *pkg) {
  * Since printing just "gpg-pubkey" is rather unhelpful, we want to ALWAYS
  * print EVRA information for these packages, even if the user specified "--evra never".
  */
-static int should_print_evra(const size_t i, const struct Package *pkg, const size_t count, int *duplicate_next) {
+static int should_print_evra(const struct Package *pkg, const struct HashMap *names) {
 	if(opt_evra == OPT_EVRA_ALWAYS) {
 		return 1;
 	}
 
 	if(opt_evra == OPT_EVRA_AUTO) {
-		/*
-		 * Compare with next package to determine whether this is a duplicate.
-		 * Since we sorted the packages by name earlier, duplicates are guaranteed
-		 * to be located next to each other in the list.
-		 *
-		 * If this is not a duplicate of the next package, check whether
-		 * the previous package set the "next package is a duplicate" flag.
-		 */
-		int duplicate_this;
-		if((i != count-1) && (strcasecmp(pkg->name, LIST_ITEM(i+1).name) == 0)) {
-			*duplicate_next = duplicate_this = 1;
-		} else {
-			duplicate_this = *duplicate_next;
-			*duplicate_next = 0;
-		}
+		// If counting the names failed, err on the side of printing too much.
+		if(names == NULL) return 1;
 
-		if(duplicate_this) return 1;
+		const struct HashMapEntry *entry = hashmap_find(names, pkg->name);
+		if((entry != NULL) && (entry->count > 1)) return 1;
 	}
 
 	return pkg->is_pubkey;
 }
 
-static void printlist(const int which_kind) {
-	int duplicate = 0;
+static int compare_hashes(const void *A, const void *B) {
+	const size_t a = *(const size_t*)A;
+	const size_t b = *(const size_t*)B;
+	return (a > b) - (a < b);
+}
 
-	const size_t count = LIST_COUNT;
+/*
+ * Count how many times each (case-folded) name appears on the list.
+ * This does not depend on the list being sorted, unlike looking
+ * for duplicates among neighbouring packages.
+ */
+static struct HashMap* count_names(void) {
+	struct HashMap *names = hashmap_init(LIST_COUNT(0) + LIST_COUNT(1), 1);
+	if(names == NULL) return NULL;
+
+	for(int kind = 0; kind < 2; ++kind) {
+		const size_t count = LIST_COUNT(kind);
+		for(size_t i = 0; i < count; ++i) {
+			struct HashMapEntry *entry = hashmap_insert(names, LIST_ITEM(kind, i).name);
+			if(entry == NULL) {
+				hashmap_free(names);
+				return NULL;
+			}
+			entry->count += 1;
+		}
+	}
+
+	// Packages that were not stored only left behind the hashes of their names.
+	// A collision would merely cause an unnecessary E:V-R.A to be printed.
+	const size_t hash_count = (nameHashes != NULL) ? (nameHashes->used / sizeof(size_t)) : 0;
+	if(hash_count > 0) {
+		qsort(nameHashes->data, hash_count, sizeof(size_t), &compare_hashes);
+		for(size_t i = 0; i < names->capacity; ++i) {
+			struct HashMapEntry *entry = &names->entries[i];
+			if(entry->key == NULL) continue;
+			if(bsearch(&entry->hash, nameHashes->data, hash_count, sizeof(size_t), &compare_hashes) != NULL) entry->count += 1;
+		}
+	}
+	return names;
+}
+
+static void printlist(const int which_kind, const struct HashMap *names) {
+	const size_t count = LIST_COUNT(which_kind);
 	for(size_t i = 0; i < count; ++i) {
-		struct Package *pkg = &LIST_ITEM(i);
-		if(pkg->licence->is_free != which_kind) continue;
+		struct Package *pkg = &LIST_ITEM(which_kind, i);
 
 		printf(" - %s", pkg->name);
-		if(should_print_evra(i, pkg, count, &duplicate)) print_evra(pkg);
+		if(should_print_evra(pkg, names)) print_evra(pkg);
 		if(opt_describe) printf(": %s", pkg->summary);
 
 		if(opt_explain) {
 			printf("\n   ");
-			licence_printNode(pkg->licence);
+			bytecode_print(stdout, pkg->licence_code, pkg->licence_string);
 		}
 		putc('\n', stdout);
 	}
 }
 
+static int compare_licence_counts(const void *A, const void *B) {
+	const struct HashMapEntry *a = *(const struct HashMapEntry *const*)A;
+	const struct HashMapEntry *b = *(const struct HashMapEntry *const*)B;
+	const struct LicenceCount *ca = a->data;
+	const struct LicenceCount *cb = b->data;
+
+	if(ca->packages != cb->packages) return (ca->packages < cb->packages) ? +1 : -1;
+	return strcmp(a->key, b->key);
+}
+
+// Print the histogram, starting with the most commonly used licences.
+static void print_licence_counts(const struct HashMap *map) {
+	if((map == NULL) || (map->used == 0)) return;
+
+	const struct HashMapEntry **entries = malloc(map->used * sizeof(struct HashMapEntry*));
+	if(entries == NULL) return;
+
+	size_t count = 0;
+	for(size_t i = 0; i < map->capacity; ++i) {
+		if(map->entries[i].key != NULL) entries[count++] = &map->entries[i];
+	}
+	qsort(entries, count, sizeof(struct HashMapEntry*), &compare_licence_counts);
+
+	for(size_t i = 0; i < count; ++i) {
+		const struct LicenceCount *counter = entries[i]->data;
+		// Expressions are printed as a whole, coloured by their final verdict.
+		const struct LicenceTreeNode node = {
+			.type = LTNT_LICENCE,
+			.is_free = counter->is_free,
+			.licence = (char*)entries[i]->key,
+		};
+		printf(" %6zu  ", counter->packages);
+		licence_printNode(&node);
+		putc('\n', stdout);
+	}
+	free(entries);
+}
+
+int packages_needSort(void) {
+	// Snapshots are always sorted, as diffing relies on that.
+	if((opt_diffagainst != NULL) || (opt_savesnapshot != NULL)) return 1;
+	return (opt_list != 0) && (!opt_unsorted);
+}
+
 void packages_list(void) {
-	if(!sorted) packages_sort();
+	// When only the counts are printed, or the user doesn't care about the order,
+	// there's no need to spend time on sorting.
+	if(packages_needSort()) packages_sort();
+
+	struct HashMap *names = NULL;
+	if((opt_list != 0) && (opt_evra == OPT_EVRA_AUTO)) names = count_names();
 	
-	int promil_nonfree = (1000L * class_count[0]) / (class_count[0] + class_count[1]);
+	const int total = class_count[0][0] + class_count[0][1];
+	int promil_nonfree = (total > 0) ? (1000L * class_count[0][0]) / total : 0;
 	int promil_free = 1000 - promil_nonfree;
 	
 	char percent_nonfree[16], percent_free[16];
 	snprintf(percent_nonfree, sizeof(percent_nonfree), "%d.%d%%", promil_nonfree / 10, promil_nonfree % 10);
 	snprintf(percent_free, sizeof(percent_nonfree), "%d.%d%%", promil_free / 10, promil_free % 10);
 	
-	lang_print_n(MSG_FREE_PACKAGES_COUNT, class_count[1], class_count[1], percent_free);
-	if(opt_list & OPT_LIST_FREE) printlist(1);
+	lang_print_n(MSG_FREE_PACKAGES_COUNT, class_count[0][1], class_count[0][1], percent_free);
+	if(opt_list & OPT_LIST_FREE) printlist(1, names);
 	
-	lang_print_n(MSG_NONFREE_PACKAGES_COUNT, class_count[0], class_count[0], percent_nonfree);
-	if(opt_list & OPT_LIST_NONFREE) printlist(0);
+	lang_print_n(MSG_NONFREE_PACKAGES_COUNT, class_count[0][0], class_count[0][0], percent_nonfree);
+	if(opt_list & OPT_LIST_NONFREE) printlist(0, names);
+
+	hashmap_free(names);
+
+	if(opt_licencelistcount > 1) {
+		putc('\n', stdout);
+		lang_print(MSG_LICENCE_LIST_COUNTS);
+		for(int i = 0; i < opt_licencelistcount; ++i) {
+			printf(" %6d  %6d  %s\n", class_count[i][1], class_count[i][0], opt_licencelist[i]);
+		}
+	}
+
+	if(opt_summarybylicence) {
+		putc('\n', stdout);
+		lang_print(MSG_LICENCE_SUMMARY_LEAVES);
+		print_licence_counts(leafCounts);
+
+		putc('\n', stdout);
+		lang_print(MSG_LICENCE_SUMMARY_EXPRESSIONS);
+		print_licence_counts(expressionCounts);
+	}
+}
+
+int packages_saveSnapshot(const char *path) {
+	packages_sort();
+
+	struct SnapshotWriter *writer = snapshot_create(path, LIST_COUNT(0) + LIST_COUNT(1));
+	if(writer == NULL) return -1;
+
+	size_t position[2] = { 0, 0 };
+	const struct Package *pkg;
+	while((pkg = next_package(position)) != NULL) {
+		const struct SnapshotEntry entry = {
+			.name = pkg->name,
+			.epoch = pkg->epoch,
+			.version = pkg->version,
+			.release = pkg->release,
+			.arch = pkg->arch,
+			.licence = pkg->licence_string,
+			.is_free = pkg->is_free,
+		};
+		if(snapshot_append(writer, &entry) != 0) break;
+	}
+	return snapshot_close(writer);
+}
+
+static const char* class_name(int is_free) {
+	return is_free ? "free" : "non-free";
+}
+
+static void print_snapshot_entry(char marker, const struct SnapshotEntry *entry) {
+	printf("%c %s", marker, entry->name);
+	print_evra_fields(entry->epoch, entry->version, entry->release, entry->arch);
+	printf(" (%s)\n", class_name(entry->is_free));
+	if(opt_explain) printf("   %s\n", entry->licence);
+}
+
+static void print_package(char marker, const struct Package *pkg) {
+	printf("%c %s", marker, pkg->name);
+	print_evra(pkg);
+	printf(" (%s)\n", class_name(pkg->is_free));
+	if(opt_explain) printf("   %s\n", pkg->licence_string);
+}
+
+static int compare_with_snapshot(const struct SnapshotEntry *entry, const struct Package *pkg) {
+	return compare_nevra(NEVRA_KEY(entry), NEVRA_KEY(pkg));
+}
+
+/*
+ * Both the snapshot and the package list are sorted the same way,
+ * so they can be walked side by side (a merge-join), comparing only the keys.
+ * The current packages have already been classified while being read; the verdicts
+ * stored in the snapshot are only compared with those, never reused in their place.
+ * That way, a change to the licence list or the grammar shows up as a reclassification.
+ */
+int packages_diffSnapshot(const char *path) {
+	struct Snapshot *snapshot = snapshot_read(path, TOKENISE_EVRS);
+	if(snapshot == NULL) return -1;
+
+	const struct SnapshotEntry *old = snapshot->entries;
+	for(size_t i = 1; i < snapshot->count; ++i) {
+		const struct SnapshotEntry *prev = &old[i - 1];
+		if(compare_nevra(NEVRA_KEY(prev), NEVRA_KEY(&old[i])) > 0) {
+			snapshot_free(snapshot);
+			return -1;
+		}
+	}
+
+	packages_sort();
+
+	const size_t old_count = snapshot->count;
+	int added = 0, removed = 0, reclassified = 0;
+
+	size_t o = 0, position[2] = { 0, 0 };
+	const struct Package *pkg = next_package(position);
+	while((o < old_count) || (pkg != NULL)) {
+		int cmp;
+		if(o == old_count)
+			cmp = 1;
+		else if(pkg == NULL)
+			cmp = -1;
+		else
+			cmp = compare_with_snapshot(&old[o], pkg);
+
+		if(cmp < 0) {
+			print_snapshot_entry('-', &old[o]);
+			++removed;
+			++o;
+		} else if(cmp > 0) {
+			print_package('+', pkg);
+			++added;
+			pkg = next_package(position);
+		} else {
+			if(old[o].is_free != pkg->is_free) {
+				printf("~ %s", pkg->name);
+				print_evra(pkg);
+				printf(" (%s -> %s)\n", class_name(old[o].is_free), class_name(pkg->is_free));
+				if(opt_explain) printf("   %s -> %s\n", old[o].licence, pkg->licence_string);
+				++reclassified;
+			}
+			++o;
+			pkg = next_package(position);
+		}
+	}
+	snapshot_free(snapshot);
+
+	lang_print(MSG_SNAPSHOT_DIFF_SUMMARY, added, removed, reclassified);
+	return added + removed + reclassified;
 }
 
 void packages_getcount(int *free, int *nonfree) {
-	if(free != NULL) *free = class_count[1];
-	if(nonfree != NULL) *nonfree = class_count[0];
+	if(free != NULL) *free = class_count[0][1];
+	if(nonfree != NULL) *nonfree = class_count[0][0];
 }
@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2023-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -18,15 +18,47 @@
 #ifndef VRMS_RPM_PACKAGES_H
 #define VRMS_RPM_PACKAGES_H
 
+#include <stdio.h>
+
 #include "src/classifiers.h"
 #include "src/pipes.h"
 
+// Package data, as received from one of the input sources.
+// Epoch and arch can be NULL. The summary is only used with --describe.
+// The strings may be modified (e.g. trimmed) by packages_add().
+struct PackageInfo {
+	char *name, *epoch, *version, *release, *arch;
+	char *licence, *summary;
+	int is_pubkey;
+};
+
+// Check whether the rpm binary is available, i.e. whether packages_openPipe() can work.
+extern int packages_canOpenPipe(void);
 extern struct Pipe* packages_openPipe(void);
 extern int packages_read(struct Pipe *pipe, struct LicenceClassifier *classifier);
+extern int packages_readFile(FILE *file, struct LicenceClassifier *classifier);
+extern int packages_add(struct PackageInfo *info, struct LicenceClassifier *classifier);
+
+// Check whether the --fail-on-nonfree threshold has been reached, in which case
+// there's no point in reading any more packages. Readers should check this after every package.
+extern int packages_shouldStop(void);
+
+// Check whether the package is a "gpg-pubkey" pseudo-package used to store imported GPG keys.
+extern int packages_isPubkey(const char *name, const char *arch, int has_pubkeys, const char *licence);
 
 extern void packages_getcount(int *free, int *nonfree);
+extern int packages_needSort(void);
+extern void packages_sort(void);
 extern void packages_list(void);
 
+// Write the (sorted) package list and classification results to a snapshot file.
+// Returns 0 on success, -1 on failure.
+extern int packages_saveSnapshot(const char *path);
+
+// Print packages that were added, removed or reclassified since the snapshot was taken.
+// Returns the number of changes, or -1 if the snapshot could not be read.
+extern int packages_diffSnapshot(const char *path);
+
 extern void packages_free(void);
 
 #endif
@@ -14,8 +14,14 @@
  * You should have received a copy of the GNU General Public License along with
  * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
  */
+// Needed for F_SETPIPE_SZ and pipe2().
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <signal.h>
+#include <spawn.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
@@ -25,66 +31,107 @@
 #include "src/lang.h"
 #include "src/pipes.h"
 
-#define FD_STDIN  0
 #define FD_STDOUT 1
-#define FD_STDERR 2
+
+// rpm can easily produce a few megabytes of output. With the default 64 KiB buffer,
+// it has to wait for us to catch up quite often; a bigger buffer means fewer context switches.
+// 1 MiB is the default limit for unprivileged processes on Linux.
+#define PIPE_BUFFER_SIZE  (1024 * 1024)
+
+extern char **environ;
 
 struct Pipe {
 	int readfd;
 	int writefd;
 	pid_t child_pid;
+	int terminated;
+	unsigned int timeout;
 };
 
-static void child(struct Pipe *const pipe, char **argv) {
-	// Close our copy of the stdout file descriptor (inherited from parent)
-	// and replace it with the write-descriptor for the pipe.
-	close(FD_STDOUT);
-	dup2(pipe->writefd, FD_STDOUT);
-	
-	execv(argv[0], argv);
-	exit(EXIT_FAILURE);
+// The timeout is implemented using alarm(), so only one pipe at a time can have one.
+static volatile pid_t timeout_pid = 0;
+static volatile sig_atomic_t timed_out = 0;
+
+static void on_timeout(int signal) {
+	(void)signal;
+	timed_out = 1;
+	kill(timeout_pid, SIGKILL);
 }
 
-static void parent(struct Pipe *const pipe) {
-	// Close our copy of the write-descriptor for the pipe.
-	// If we leave it open, we won't be able to ever reach EOF
-	// on the pipe's read-descriptor.
-	close(pipe->writefd);
+static int arm_timeout(struct Pipe *pipe) {
+	// No SA_RESTART - a read blocked on the pipe should be interrupted,
+	// since the child might have left behind processes that keep the pipe open.
+	struct sigaction action = { .sa_handler = &on_timeout };
+	sigemptyset(&action.sa_mask);
+	if(sigaction(SIGALRM, &action, NULL) != 0) return -1;
+
+	timed_out = 0;
+	timeout_pid = pipe->child_pid;
+	alarm(pipe->timeout);
+	return 0;
+}
+
+static void disarm_timeout(void) {
+	alarm(0);
+	signal(SIGALRM, SIG_DFL);
 }
 
-struct Pipe* pipe_create(char **argv) {
+struct Pipe* pipe_create(char **argv, unsigned int timeout) {
 	struct Pipe *res = malloc(sizeof(struct Pipe));
 	if(res == NULL) return NULL;
-	
+
+	// Neither end of the pipe should leak into the child;
+	// its stdout is set up separately, via the file actions below.
 	int pipefd[2];
-	if(pipe(pipefd) != 0) {
-		free(res);
-		return NULL;
-	}
-	
-	pid_t pid = fork();
-	if(pid == -1) {
-		close(pipefd[0]);
-		close(pipefd[1]);
+	if(pipe2(pipefd, O_CLOEXEC) != 0) {
 		free(res);
 		return NULL;
 	}
-	
+#ifdef F_SETPIPE_SZ
+	// Not a problem if this fails; the default size works, just a bit slower.
+	fcntl(pipefd[1], F_SETPIPE_SZ, PIPE_BUFFER_SIZE);
+#endif
+
 	res->readfd = pipefd[0];
 	res->writefd = pipefd[1];
+	res->child_pid = -1;
+	res->terminated = 0;
+	res->timeout = timeout;
+
+	// posix_spawn() avoids copying the page tables of the parent process, like fork() would.
+	posix_spawn_file_actions_t actions;
+	if(posix_spawn_file_actions_init(&actions) != 0) goto fail;
+
+	pid_t pid;
+	int spawned = posix_spawn_file_actions_adddup2(&actions, res->writefd, FD_STDOUT);
+	if(spawned == 0) spawned = posix_spawn(&pid, argv[0], &actions, NULL, argv, environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if(spawned != 0) goto fail;
+
+	// Close our copy of the write-descriptor for the pipe.
+	// If we leave it open, we won't be able to ever reach EOF
+	// on the pipe's read-descriptor.
+	close(res->writefd);
+	res->writefd = -1;
 	res->child_pid = pid;
-	
-	if(pid == 0)
-		child(res, argv);
-	else
-		parent(res);
-	
+
+	if((timeout > 0) && (arm_timeout(res) != 0)) {
+		pipe_terminate(res);
+		pipe_destroy(res);
+		return NULL;
+	}
 	return res;
+
+	fail: { // As seen in CVE-2014-1266!
+		close(res->readfd);
+		close(res->writefd);
+		free(res);
+		return NULL;
+	}
 }
 
 FILE* pipe_fopen(struct Pipe *pipe) {
 	const int fd = pipe->readfd;
-	free(pipe);
 	
 	struct pollfd pfd = {
 		.fd = fd, 
@@ -93,6 +140,9 @@ FILE* pipe_fopen(struct Pipe *pipe) {
 	
 	int events = poll(&pfd, 1, -1);
 	if(events < 0) {
+		// Interrupted by the timeout; pipe_destroy() reports that.
+		if((errno == EINTR) && timed_out) return NULL;
+
 		lang_fprint(stderr, MSG_ERR_PIPE_NOEVENTS);
 		return NULL;
 	}
@@ -108,11 +158,45 @@ FILE* pipe_fopen(struct Pipe *pipe) {
 		return NULL;
 	}
 	
-	return fdopen(fd, "r");
+	FILE *f = fdopen(fd, "r");
+	if(f != NULL) pipe->readfd = -1;
+	return f;
+}
+
+void pipe_terminate(struct Pipe *pipe) {
+	if(pipe->child_pid > 0) {
+		kill(pipe->child_pid, SIGTERM);
+		pipe->terminated = 1;
+	}
 }
 
-void pipe_destroy(struct Pipe *pipe) {
-	close(pipe->readfd);
-	close(pipe->writefd);
+int pipe_destroy(struct Pipe *pipe) {
+	if(pipe->readfd >= 0) close(pipe->readfd);
+	if(pipe->writefd >= 0) close(pipe->writefd);
+
+	int result = PIPE_CHILD_OK;
+	if(pipe->child_pid > 0) {
+		// Wait for the child to exit, but don't reap it until the timeout is disarmed -
+		// otherwise, the pid could get reused before the alarm handler gets to kill() it.
+		siginfo_t info;
+		while((waitid(P_PID, pipe->child_pid, &info, WEXITED | WNOWAIT) != 0) && (errno == EINTR)) {}
+		if(pipe->timeout > 0) disarm_timeout();
+
+		int status;
+		pid_t waited;
+		do {
+			waited = waitpid(pipe->child_pid, &status, 0);
+		} while((waited < 0) && (errno == EINTR));
+
+		if((pipe->timeout > 0) && timed_out) {
+			result = PIPE_CHILD_TIMEOUT;
+		} else if(pipe->terminated) {
+			// We asked the child to stop, so whatever it returned is fine.
+		} else if((waited < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+			result = PIPE_CHILD_FAILED;
+		}
+	}
+
 	free(pipe);
+	return result;
 }
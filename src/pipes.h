@@ -22,10 +22,25 @@
 
 struct Pipe;
 
+// Returned by pipe_destroy().
+#define PIPE_CHILD_OK        0
+#define PIPE_CHILD_FAILED   -1
+#define PIPE_CHILD_TIMEOUT  -2
 
-extern struct Pipe* pipe_create(char **argv);
+// Run argv[0] (which must be a full path) with its stdout connected to the pipe.
+// When the timeout (in seconds) is non-zero, the child gets killed if it runs for longer than that.
+// Since this relies on alarm(), only one pipe with a timeout can exist at a time.
+extern struct Pipe* pipe_create(char **argv, unsigned int timeout);
+// The returned FILE takes over the read-descriptor; the pipe itself
+// must still be destroyed afterwards, in order to reap the child process.
 extern FILE* pipe_fopen(struct Pipe *pipe);
 
-extern void pipe_destroy(struct Pipe *pipe);
+// Ask the child process to stop, e.g. when its output is no longer needed.
+extern void pipe_terminate(struct Pipe *pipe);
+
+// Wait for the child process to finish and free the pipe.
+// Returns PIPE_CHILD_OK if the child exited successfully (or was asked to terminate),
+// PIPE_CHILD_TIMEOUT if it was killed after running out of time, or PIPE_CHILD_FAILED otherwise.
+extern int pipe_destroy(struct Pipe *pipe);
 
 #endif
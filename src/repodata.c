@@ -0,0 +1,493 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef WITH_REPODATA
+#include <expat.h>
+#include <zlib.h>
+#endif
+
+#ifdef WITH_SQLITE
+#include <sqlite3.h>
+#endif
+
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "src/options.h"
+#include "src/packages.h"
+#include "src/repodata.h"
+#include "src/stats.h"
+
+#define MAGIC_LEN 16
+
+static const unsigned char MAGIC_ZSTD[] = { 0x28, 0xB5, 0x2F, 0xFD };
+static const unsigned char MAGIC_SQLITE[] = "SQLite format 3";
+
+#define HAS_MAGIC(buffer, len, magic)  (((len) >= sizeof(magic)) && (memcmp((buffer), (magic), sizeof(magic)) == 0))
+
+// Timing individual packages adds a few syscalls per package, so only do it when asked to.
+#define DETAILED_STATS_BEGIN(phase)  do { if(opt_stats) stats_begin(STATS_PHASE_ ## phase); } while(0)
+#define DETAILED_STATS_END(phase)    do { if(opt_stats) stats_end(STATS_PHASE_ ## phase); } while(0)
+
+#ifdef WITH_REPODATA
+
+/*
+ * A source of (possibly decompressed) data for the XML parser.
+ * read() returns the number of bytes read, 0 on end-of-file, or -1 on error.
+ */
+struct Reader {
+	long(*read)(struct Reader *self, char *buffer, size_t size);
+	void(*close)(struct Reader *self);
+};
+
+// zlib handles uncompressed files transparently, so this is used for both plain and gzipped XML.
+struct GzipReader {
+	struct Reader interface;
+	gzFile file;
+};
+
+static long gzip_read(struct Reader *reader, char *buffer, size_t size) {
+	struct GzipReader *self = (struct GzipReader*)reader;
+	const int result = gzread(self->file, buffer, size);
+	return (result >= 0) ? result : -1;
+}
+
+static void gzip_close(struct Reader *reader) {
+	struct GzipReader *self = (struct GzipReader*)reader;
+	gzclose(self->file);
+	free(self);
+}
+
+static struct Reader* gzip_open(FILE *file) {
+	struct GzipReader *self = malloc(sizeof(struct GzipReader));
+	if(self == NULL) return NULL;
+
+	// gzclose() closes the descriptor, so give zlib a copy of its own.
+	// The stdio buffer may have read ahead, so move the descriptor to where the stream is.
+	const int fd = dup(fileno(file));
+	if((fd >= 0) && (lseek(fd, ftell(file), SEEK_SET) < 0)) {
+		close(fd);
+		free(self);
+		return NULL;
+	}
+	self->file = (fd >= 0) ? gzdopen(fd, "rb") : NULL;
+	if(self->file == NULL) {
+		if(fd >= 0) close(fd);
+		free(self);
+		return NULL;
+	}
+
+	self->interface.read = &gzip_read;
+	self->interface.close = &gzip_close;
+	return &self->interface;
+}
+
+#ifdef WITH_ZSTD
+struct ZstdReader {
+	struct Reader interface;
+	FILE *file;
+	ZSTD_DStream *stream;
+	ZSTD_inBuffer input;
+	size_t input_capacity;
+	int eof;
+	int flushing;
+	char input_data[];
+};
+
+static long zstd_read(struct Reader *reader, char *buffer, size_t size) {
+	struct ZstdReader *self = (struct ZstdReader*)reader;
+	ZSTD_outBuffer output = { .dst = buffer, .size = size, .pos = 0 };
+
+	while(output.pos == 0) {
+		// The decoder can hold on to output even after consuming all of the input,
+		// so only read more (or give up at EOF) once a call made no more progress.
+		if((self->input.pos == self->input.size) && !self->flushing) {
+			if(self->eof) break;
+
+			self->input.size = fread(self->input_data, 1, self->input_capacity, self->file);
+			self->input.pos = 0;
+			if(self->input.size == 0) {
+				if(ferror(self->file)) return -1;
+				self->eof = 1;
+				break;
+			}
+		}
+
+		const size_t result = ZSTD_decompressStream(self->stream, &output, &self->input);
+		if(ZSTD_isError(result)) return -1;
+
+		self->flushing = (result != 0) && (output.pos == output.size);
+	}
+	return output.pos;
+}
+
+static void zstd_close(struct Reader *reader) {
+	struct ZstdReader *self = (struct ZstdReader*)reader;
+	ZSTD_freeDStream(self->stream);
+	free(self);
+}
+
+static struct Reader* zstd_open(FILE *file) {
+	const size_t input_capacity = ZSTD_DStreamInSize();
+
+	struct ZstdReader *self = malloc(sizeof(struct ZstdReader) + input_capacity);
+	if(self == NULL) return NULL;
+
+	self->stream = ZSTD_createDStream();
+	if(self->stream == NULL) {
+		free(self);
+		return NULL;
+	}
+	ZSTD_initDStream(self->stream);
+
+	self->file = file;
+	self->input = (ZSTD_inBuffer){ .src = self->input_data, .size = 0, .pos = 0 };
+	self->input_capacity = input_capacity;
+	self->eof = 0;
+	self->flushing = 0;
+
+	self->interface.read = &zstd_read;
+	self->interface.close = &zstd_close;
+	return &self->interface;
+}
+#endif
+
+/*
+ * The parser is set up with namespace processing enabled, so element names
+ * are reported as "namespace-URI|local-name", regardless of the prefixes used.
+ */
+#define NS_SEPARATOR '|'
+#define NS_COMMON "http://linux.duke.edu/metadata/common|"
+#define NS_RPM    "http://linux.duke.edu/metadata/rpm|"
+
+enum Field {
+	FIELD_NAME,
+	FIELD_ARCH,
+	FIELD_EPOCH,
+	FIELD_VERSION,
+	FIELD_RELEASE,
+	FIELD_LICENCE,
+	FIELD_SUMMARY,
+	FIELD_COUNT,
+	FIELD_NONE = FIELD_COUNT,
+};
+
+// Text longer than this gets truncated. This keeps memory usage bounded,
+// no matter how large the file is; the licence buffer in packages.c is of the same size.
+#define FIELD_MAX_LEN 4095
+
+struct ParserState {
+	XML_Parser parser;
+	struct LicenceClassifier *classifier;
+	int in_package;
+	enum Field current;
+	int failed;
+
+	size_t len[FIELD_COUNT];
+	char text[FIELD_COUNT][FIELD_MAX_LEN + 1];
+};
+
+static void set_field(struct ParserState *state, enum Field field, const char *value) {
+	size_t len = strlen(value);
+	if(len > FIELD_MAX_LEN) len = FIELD_MAX_LEN;
+
+	memcpy(state->text[field], value, len);
+	state->text[field][len] = '\0';
+	state->len[field] = len;
+}
+
+static void on_start(void *data, const XML_Char *element, const XML_Char **attributes) {
+	struct ParserState *state = data;
+
+	if(strcmp(element, NS_COMMON "package") == 0) {
+		state->in_package = 1;
+		for(int f = 0; f < FIELD_COUNT; ++f) {
+			state->len[f] = 0;
+			state->text[f][0] = '\0';
+		}
+		return;
+	}
+	if(!state->in_package) return;
+
+	if(strcmp(element, NS_COMMON "name") == 0) {
+		state->current = FIELD_NAME;
+	} else if(strcmp(element, NS_COMMON "arch") == 0) {
+		state->current = FIELD_ARCH;
+	} else if(strcmp(element, NS_RPM "license") == 0) {
+		state->current = FIELD_LICENCE;
+	} else if((strcmp(element, NS_COMMON "summary") == 0) && opt_describe) {
+		state->current = FIELD_SUMMARY;
+	} else if(strcmp(element, NS_COMMON "version") == 0) {
+		for(int a = 0; attributes[a] != NULL; a += 2) {
+			if(strcmp(attributes[a], "epoch") == 0)
+				set_field(state, FIELD_EPOCH, attributes[a+1]);
+			else if(strcmp(attributes[a], "ver") == 0)
+				set_field(state, FIELD_VERSION, attributes[a+1]);
+			else if(strcmp(attributes[a], "rel") == 0)
+				set_field(state, FIELD_RELEASE, attributes[a+1]);
+		}
+	}
+}
+
+static void on_text(void *data, const XML_Char *text, int len) {
+	struct ParserState *state = data;
+	if(state->current == FIELD_NONE) return;
+
+	const size_t used = state->len[state->current];
+	size_t copy = len;
+	if(copy > FIELD_MAX_LEN - used) copy = FIELD_MAX_LEN - used;
+
+	memcpy(state->text[state->current] + used, text, copy);
+	state->len[state->current] = used + copy;
+	state->text[state->current][used + copy] = '\0';
+}
+
+static void on_end(void *data, const XML_Char *element) {
+	struct ParserState *state = data;
+	state->current = FIELD_NONE;
+
+	if(!state->in_package || (strcmp(element, NS_COMMON "package") != 0)) return;
+	state->in_package = 0;
+
+	// createrepo writes epoch="0" for packages without an epoch,
+	// so there's no way to tell these two cases apart. Treat both as "no epoch",
+	// the same way "rpm --query" output would look like.
+	char *epoch = state->text[FIELD_EPOCH];
+	if((epoch[0] == '\0') || (strcmp(epoch, "0") == 0)) epoch = NULL;
+
+	struct PackageInfo info = {
+		.name = state->text[FIELD_NAME],
+		.epoch = epoch,
+		.version = state->text[FIELD_VERSION],
+		.release = state->text[FIELD_RELEASE],
+		.arch = (state->len[FIELD_ARCH] > 0) ? state->text[FIELD_ARCH] : NULL,
+		.licence = state->text[FIELD_LICENCE],
+		.summary = state->text[FIELD_SUMMARY],
+		.is_pubkey = 0,
+	};
+	stats_count(LINES_READ);
+	if(packages_add(&info, state->classifier) != 0) {
+		state->failed = 1;
+		XML_StopParser(state->parser, XML_FALSE);
+	} else if(packages_shouldStop()) {
+		XML_StopParser(state->parser, XML_FALSE);
+	}
+}
+
+static int parse_xml(struct Reader *reader, struct LicenceClassifier *classifier) {
+	struct ParserState *state = malloc(sizeof(struct ParserState));
+	if(state == NULL) return REPODATA_READ_FAILED;
+
+	state->parser = XML_ParserCreateNS(NULL, NS_SEPARATOR);
+	if(state->parser == NULL) {
+		free(state);
+		return REPODATA_READ_FAILED;
+	}
+	state->classifier = classifier;
+	state->in_package = 0;
+	state->current = FIELD_NONE;
+	state->failed = 0;
+
+	XML_SetUserData(state->parser, state);
+	XML_SetElementHandler(state->parser, &on_start, &on_end);
+	XML_SetCharacterDataHandler(state->parser, &on_text);
+
+	int result = REPODATA_OK;
+	for(;;) {
+		#define CHUNK_SIZE 65536
+		void *chunk = XML_GetBuffer(state->parser, CHUNK_SIZE);
+		if(chunk == NULL) {
+			result = REPODATA_READ_FAILED;
+			break;
+		}
+
+		DETAILED_STATS_BEGIN(READ_WAIT);
+		const long len = reader->read(reader, chunk, CHUNK_SIZE);
+		DETAILED_STATS_END(READ_WAIT);
+		if(len < 0) {
+			result = REPODATA_READ_FAILED;
+			break;
+		}
+
+		const enum XML_Status status = XML_ParseBuffer(state->parser, len, len == 0);
+		if(state->failed) {
+			result = REPODATA_READ_FAILED;
+			break;
+		}
+		if(packages_shouldStop()) break;
+		if(status != XML_STATUS_OK) {
+			result = REPODATA_READ_FAILED;
+			break;
+		}
+		if(len == 0) break;
+	}
+
+	XML_ParserFree(state->parser);
+	free(state);
+	return result;
+}
+
+#endif // WITH_REPODATA
+
+#ifdef WITH_SQLITE
+
+#define SQLITE_QUERY "SELECT name, epoch, version, release, arch, rpm_license, summary FROM packages"
+
+// sqlite3_column_text() returns unsigned chars; packages_add() wants mutable, plain ones.
+static char* column_copy(sqlite3_stmt *stmt, int column, char *buffer, size_t bufsize) {
+	const unsigned char *value = sqlite3_column_text(stmt, column);
+	if(value == NULL) return NULL;
+
+	snprintf(buffer, bufsize, "%s", (const char*)value);
+	return buffer;
+}
+
+static int read_sqlite(const char *path, struct LicenceClassifier *classifier) {
+	sqlite3 *db = NULL;
+	if(sqlite3_open_v2(path, &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK) {
+		sqlite3_close(db);
+		return REPODATA_OPEN_FAILED;
+	}
+
+	sqlite3_stmt *stmt = NULL;
+	if(sqlite3_prepare_v2(db, SQLITE_QUERY, -1, &stmt, NULL) != SQLITE_OK) {
+		sqlite3_close(db);
+		return REPODATA_READ_FAILED;
+	}
+
+	int result = REPODATA_OK;
+	char name[256], epoch[32], version[256], release[256], arch[32], licence[4096], summary[4096];
+	for(;;) {
+		DETAILED_STATS_BEGIN(READ_WAIT);
+		const int step = sqlite3_step(stmt);
+		DETAILED_STATS_END(READ_WAIT);
+
+		if(step == SQLITE_DONE) break;
+		if(step != SQLITE_ROW) {
+			result = REPODATA_READ_FAILED;
+			break;
+		}
+
+		struct PackageInfo info = {
+			.name = column_copy(stmt, 0, name, sizeof(name)),
+			.epoch = column_copy(stmt, 1, epoch, sizeof(epoch)),
+			.version = column_copy(stmt, 2, version, sizeof(version)),
+			.release = column_copy(stmt, 3, release, sizeof(release)),
+			.arch = column_copy(stmt, 4, arch, sizeof(arch)),
+			.licence = column_copy(stmt, 5, licence, sizeof(licence)),
+			.summary = opt_describe ? column_copy(stmt, 6, summary, sizeof(summary)) : NULL,
+			.is_pubkey = 0,
+		};
+		if((info.name == NULL) || (info.version == NULL) || (info.release == NULL)) continue;
+		if((info.epoch != NULL) && (strcmp(info.epoch, "0") == 0)) info.epoch = NULL;
+		if(info.licence == NULL) {
+			licence[0] = '\0';
+			info.licence = licence;
+		}
+		if(opt_describe && (info.summary == NULL)) {
+			summary[0] = '\0';
+			info.summary = summary;
+		}
+
+		stats_count(LINES_READ);
+		if(packages_add(&info, classifier) != 0) {
+			result = REPODATA_READ_FAILED;
+			break;
+		}
+		if(packages_shouldStop()) break;
+	}
+
+	sqlite3_finalize(stmt);
+	sqlite3_close(db);
+	return result;
+}
+
+#endif // WITH_SQLITE
+
+static int read_xml(FILE *file, const unsigned char *magic, size_t magic_len, struct LicenceClassifier *classifier) {
+	#ifdef WITH_REPODATA
+		struct Reader *reader;
+		if(HAS_MAGIC(magic, magic_len, MAGIC_ZSTD)) {
+			#ifdef WITH_ZSTD
+				reader = zstd_open(file);
+			#else
+				return REPODATA_UNSUPPORTED;
+			#endif
+		} else {
+			reader = gzip_open(file);
+		}
+		if(reader == NULL) return REPODATA_OPEN_FAILED;
+
+		const int result = parse_xml(reader, classifier);
+		reader->close(reader);
+		return result;
+	#else
+		(void)file;
+		(void)magic;
+		(void)magic_len;
+		(void)classifier;
+		return REPODATA_UNSUPPORTED;
+	#endif
+}
+
+static int finish(const int result) {
+	if(result != REPODATA_OK) {
+		packages_free();
+		return result;
+	}
+
+	int free_count, nonfree_count;
+	packages_getcount(&free_count, &nonfree_count);
+	return free_count + nonfree_count;
+}
+
+int repodata_readFile(FILE *file, struct LicenceClassifier *classifier) {
+	unsigned char magic[MAGIC_LEN];
+	const size_t magic_len = fread(magic, 1, sizeof(magic), file);
+	rewind(file);
+
+	if(HAS_MAGIC(magic, magic_len, MAGIC_SQLITE)) return REPODATA_UNSUPPORTED;
+	return finish(read_xml(file, magic, magic_len, classifier));
+}
+
+int repodata_read(const char *path, struct LicenceClassifier *classifier) {
+	FILE *file = fopen(path, "rb");
+	if(file == NULL) return REPODATA_OPEN_FAILED;
+
+	unsigned char magic[MAGIC_LEN];
+	const size_t magic_len = fread(magic, 1, sizeof(magic), file);
+	rewind(file);
+
+	int result;
+	if(HAS_MAGIC(magic, magic_len, MAGIC_SQLITE)) {
+		fclose(file);
+		#ifdef WITH_SQLITE
+			result = read_sqlite(path, classifier);
+		#else
+			result = REPODATA_UNSUPPORTED;
+		#endif
+	} else {
+		result = read_xml(file, magic, magic_len, classifier);
+		fclose(file);
+	}
+	return finish(result);
+}
@@ -0,0 +1,41 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_REPODATA_H
+#define VRMS_RPM_REPODATA_H
+
+#include <stdio.h>
+
+#include "src/classifiers.h"
+
+#define REPODATA_OK           0
+#define REPODATA_OPEN_FAILED -1
+#define REPODATA_READ_FAILED -2
+#define REPODATA_UNSUPPORTED -3
+
+/*
+ * Read the list of packages from repository metadata, instead of the rpm database.
+ * Supported formats are primary.xml (uncompressed, gzip or zstd)
+ * and primary.sqlite (uncompressed). The format is detected based on the file contents.
+ *
+ * Returns the number of packages read, or one of the REPODATA_* error codes.
+ */
+extern int repodata_read(const char *path, struct LicenceClassifier *classifier);
+
+// Same as above, but for an already opened primary.xml file. SQLite databases are not supported here.
+extern int repodata_readFile(FILE *file, struct LicenceClassifier *classifier);
+
+#endif
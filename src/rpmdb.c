@@ -0,0 +1,247 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef WITH_SQLITE
+#include <sqlite3.h>
+#endif
+
+#include "src/header.h"
+#include "src/options.h"
+#include "src/packages.h"
+#include "src/rpmdb.h"
+#include "src/stats.h"
+
+// Timing individual packages adds a few syscalls per package, so only do it when asked to.
+#define DETAILED_STATS_BEGIN(phase)  do { if(opt_stats) stats_begin(STATS_PHASE_ ## phase); } while(0)
+#define DETAILED_STATS_END(phase)    do { if(opt_stats) stats_end(STATS_PHASE_ ## phase); } while(0)
+
+// Since rpm 4.17, the database lives in /usr/lib/sysimage/rpm;
+// /var/lib/rpm is usually a symlink, but may be the only location on older systems.
+static const char *const default_paths[] = {
+	"/usr/lib/sysimage/rpm/rpmdb.sqlite",
+	"/var/lib/rpm/rpmdb.sqlite",
+};
+
+const char* rpmdb_defaultPath(void) {
+	for(size_t i = 0; i < sizeof(default_paths) / sizeof(default_paths[0]); ++i) {
+		if(access(default_paths[i], R_OK) == 0) return default_paths[i];
+	}
+	return NULL;
+}
+
+#ifdef WITH_SQLITE
+
+#define SQLITE_QUERY "SELECT blob FROM Packages"
+
+// Mimic what "rpm --queryformat" prints for missing tags,
+// so packages are classified the same way regardless of the input source.
+#define RPM_NONE "(none)"
+
+/*
+ * The tags we need, in the order used to index the results of header_findTags().
+ * Like packages_openPipe() does with the queryformat, only ask for the summary
+ * when --describe is used - it's always the last item, so it can be cut off.
+ */
+enum WantedTag {
+	WANT_NAME,
+	WANT_EPOCH,
+	WANT_VERSION,
+	WANT_RELEASE,
+	WANT_ARCH,
+	WANT_PUBKEYS,
+	WANT_LICENSE,
+	WANT_SUMMARY,
+	WANT_COUNT
+};
+
+static const uint32_t wanted_tags[WANT_COUNT] = {
+	[WANT_NAME] = RPMTAG_NAME,
+	[WANT_EPOCH] = RPMTAG_EPOCH,
+	[WANT_VERSION] = RPMTAG_VERSION,
+	[WANT_RELEASE] = RPMTAG_RELEASE,
+	[WANT_ARCH] = RPMTAG_ARCH,
+	[WANT_PUBKEYS] = RPMTAG_PUBKEYS,
+	[WANT_LICENSE] = RPMTAG_LICENSE,
+	[WANT_SUMMARY] = RPMTAG_SUMMARY,
+};
+
+// Header strings point into memory owned by sqlite; packages_add() wants mutable ones.
+static char* string_copy(const struct Header *header, const struct HeaderEntry *entry, char *buffer, size_t bufsize) {
+	const char *value = header_entryString(header, entry);
+	if(value == NULL) return NULL;
+
+	snprintf(buffer, bufsize, "%s", value);
+	return buffer;
+}
+
+// Returns 0 on success, 1 if the header was malformed and has been skipped, -1 on error.
+static int add_package(const void *blob, size_t blob_len, struct LicenceClassifier *classifier) {
+	struct Header header;
+	if((blob == NULL) || (header_init(&header, blob, blob_len) != 0)) {
+		stats_count(LINES_REJECTED);
+		return 1;
+	}
+
+	struct HeaderEntry entries[WANT_COUNT];
+	const size_t wanted_count = opt_describe ? WANT_COUNT : WANT_SUMMARY;
+	header_findTags(&header, wanted_tags, entries, wanted_count);
+
+	char name[256], epoch[16], version[256], release[256], arch[32], licence[4096], summary[4096];
+	struct PackageInfo info = {
+		.name = string_copy(&header, &entries[WANT_NAME], name, sizeof(name)),
+		.epoch = NULL,
+		.version = string_copy(&header, &entries[WANT_VERSION], version, sizeof(version)),
+		.release = string_copy(&header, &entries[WANT_RELEASE], release, sizeof(release)),
+		.arch = string_copy(&header, &entries[WANT_ARCH], arch, sizeof(arch)),
+		.licence = string_copy(&header, &entries[WANT_LICENSE], licence, sizeof(licence)),
+		.summary = opt_describe ? string_copy(&header, &entries[WANT_SUMMARY], summary, sizeof(summary)) : NULL,
+	};
+	if((info.name == NULL) || (info.version == NULL) || (info.release == NULL)) {
+		stats_count(LINES_REJECTED);
+		return 1;
+	}
+
+	uint32_t epoch_value;
+	if(header_entryInt32(&header, &entries[WANT_EPOCH], &epoch_value) == 0) {
+		snprintf(epoch, sizeof(epoch), "%u", (unsigned int)epoch_value);
+		info.epoch = epoch;
+	}
+	if(info.licence == NULL) {
+		snprintf(licence, sizeof(licence), "%s", RPM_NONE);
+		info.licence = licence;
+	}
+	if(opt_describe && (info.summary == NULL)) {
+		snprintf(summary, sizeof(summary), "%s", RPM_NONE);
+		info.summary = summary;
+	}
+
+	const int has_pubkeys = entries[WANT_PUBKEYS].type != HEADER_TYPE_NONE;
+	info.is_pubkey = packages_isPubkey(info.name, info.arch, has_pubkeys, info.licence);
+
+	return packages_add(&info, classifier);
+}
+
+/*
+ * Build an URI that tells sqlite the database won't change while we read it.
+ * This allows reading a WAL-mode database without write access
+ * to the directory it's in (needed to create the -shm file).
+ */
+static char* immutable_uri(const char *path, char *buffer, size_t bufsize) {
+	static const char prefix[] = "file:";
+	static const char suffix[] = "?immutable=1";
+
+	size_t pos = 0;
+	if(bufsize < sizeof(prefix)) return NULL;
+	memcpy(buffer, prefix, sizeof(prefix) - 1);
+	pos += sizeof(prefix) - 1;
+
+	for(const char *c = path; *c != '\0'; ++c) {
+		const int escape = (*c == '?') || (*c == '#') || (*c == '%');
+		if(pos + (escape ? 3 : 1) >= bufsize) return NULL;
+
+		if(escape) {
+			snprintf(buffer + pos, 4, "%%%02X", (unsigned int)(unsigned char)*c);
+			pos += 3;
+		} else {
+			buffer[pos++] = *c;
+		}
+	}
+
+	if(pos + sizeof(suffix) > bufsize) return NULL;
+	memcpy(buffer + pos, suffix, sizeof(suffix));
+	return buffer;
+}
+
+static sqlite3_stmt* prepare_query(const char *path, int flags, sqlite3 **db) {
+	*db = NULL;
+	if(sqlite3_open_v2(path, db, flags, NULL) != SQLITE_OK) {
+		sqlite3_close(*db);
+		*db = NULL;
+		return NULL;
+	}
+
+	sqlite3_stmt *stmt = NULL;
+	if(sqlite3_prepare_v2(*db, SQLITE_QUERY, -1, &stmt, NULL) != SQLITE_OK) {
+		sqlite3_close(*db);
+		*db = NULL;
+		return NULL;
+	}
+	return stmt;
+}
+
+static int read_sqlite(const char *path, struct LicenceClassifier *classifier) {
+	if(access(path, R_OK) != 0) return RPMDB_OPEN_FAILED;
+
+	sqlite3 *db;
+	sqlite3_stmt *stmt = prepare_query(path, SQLITE_OPEN_READONLY, &db);
+	if(stmt == NULL) {
+		char uri[4096];
+		if(immutable_uri(path, uri, sizeof(uri)) != NULL) {
+			stmt = prepare_query(uri, SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, &db);
+		}
+		if(stmt == NULL) return RPMDB_READ_FAILED;
+	}
+
+	int result = RPMDB_OK;
+	for(;;) {
+		DETAILED_STATS_BEGIN(READ_WAIT);
+		const int step = sqlite3_step(stmt);
+		DETAILED_STATS_END(READ_WAIT);
+
+		if(step == SQLITE_DONE) break;
+		if(step != SQLITE_ROW) {
+			result = RPMDB_READ_FAILED;
+			break;
+		}
+
+		stats_count(LINES_READ);
+		const void *blob = sqlite3_column_blob(stmt, 0);
+		const int blob_len = sqlite3_column_bytes(stmt, 0);
+		if(add_package(blob, (size_t)blob_len, classifier) < 0) {
+			result = RPMDB_READ_FAILED;
+			break;
+		}
+		if(packages_shouldStop()) break;
+	}
+
+	sqlite3_finalize(stmt);
+	sqlite3_close(db);
+	return result;
+}
+
+#endif // WITH_SQLITE
+
+int rpmdb_read(const char *path, struct LicenceClassifier *classifier) {
+	#ifdef WITH_SQLITE
+		const int result = read_sqlite(path, classifier);
+		if(result != RPMDB_OK) {
+			packages_free();
+			return result;
+		}
+
+		int free_count, nonfree_count;
+		packages_getcount(&free_count, &nonfree_count);
+		return free_count + nonfree_count;
+	#else
+		(void)path;
+		(void)classifier;
+		return RPMDB_UNSUPPORTED;
+	#endif
+}
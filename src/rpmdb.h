@@ -0,0 +1,39 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_RPMDB_H
+#define VRMS_RPM_RPMDB_H
+
+#include "src/classifiers.h"
+
+#define RPMDB_OK           0
+#define RPMDB_OPEN_FAILED -1
+#define RPMDB_READ_FAILED -2
+#define RPMDB_UNSUPPORTED -3
+
+/*
+ * Read the list of packages straight from an SQLite rpm database,
+ * without going through rpm or librpm. Useful on minimal systems
+ * (e.g. container images) that have the database, but not rpm itself.
+ *
+ * Returns the number of packages read, or one of the RPMDB_* error codes.
+ */
+extern int rpmdb_read(const char *path, struct LicenceClassifier *classifier);
+
+// Returns the path to the system rpm database, or NULL if none could be found.
+extern const char* rpmdb_defaultPath(void);
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/buffers.h"
+#include "src/snapshot.h"
+#include "src/versions.h"
+
+#define MAGIC "VRMSSNP1"
+#define MAGIC_LEN (sizeof(MAGIC) - 1)
+#define HEADER_LEN (MAGIC_LEN + 4)
+
+#define FLAG_FREE      (1 << 0)
+#define FLAG_HAS_EPOCH (1 << 1)
+#define FLAG_HAS_ARCH  (1 << 2)
+
+// Any snapshot larger than this is surely not something we wrote.
+#define MAX_SNAPSHOT_SIZE (256L * 1024 * 1024)
+
+struct SnapshotWriter {
+	FILE *file;
+	size_t expected, written;
+};
+
+struct SnapshotWriter* snapshot_create(const char *path, size_t count) {
+	if(count > UINT32_MAX) return NULL;
+
+	struct SnapshotWriter *writer = malloc(sizeof(struct SnapshotWriter));
+	if(writer == NULL) return NULL;
+
+	writer->file = fopen(path, "wb");
+	if(writer->file == NULL) {
+		free(writer);
+		return NULL;
+	}
+	writer->expected = count;
+	writer->written = 0;
+
+	const unsigned char size[4] = { (count >> 24) & 0xFF, (count >> 16) & 0xFF, (count >> 8) & 0xFF, count & 0xFF };
+	fwrite(MAGIC, 1, MAGIC_LEN, writer->file);
+	fwrite(size, 1, sizeof(size), writer->file);
+	return writer;
+}
+
+static void write_string(FILE *file, const char *str) {
+	fwrite(str, 1, strlen(str) + 1, file);
+}
+
+int snapshot_append(struct SnapshotWriter *writer, const struct SnapshotEntry *entry) {
+	if(writer->written == writer->expected) return -1;
+
+	int flags = 0;
+	if(entry->is_free) flags |= FLAG_FREE;
+	if(entry->epoch != NULL) flags |= FLAG_HAS_EPOCH;
+	if(entry->arch != NULL) flags |= FLAG_HAS_ARCH;
+	putc(flags, writer->file);
+
+	write_string(writer->file, entry->name);
+	if(entry->epoch != NULL) write_string(writer->file, entry->epoch);
+	write_string(writer->file, entry->version);
+	write_string(writer->file, entry->release);
+	if(entry->arch != NULL) write_string(writer->file, entry->arch);
+	write_string(writer->file, entry->licence);
+
+	writer->written += 1;
+	return ferror(writer->file) ? -1 : 0;
+}
+
+int snapshot_close(struct SnapshotWriter *writer) {
+	int result = (writer->written == writer->expected) && !ferror(writer->file) ? 0 : -1;
+	if(fclose(writer->file) != 0) result = -1;
+	free(writer);
+	return result;
+}
+
+static char* read_file(const char *path, size_t *size) {
+	FILE *file = fopen(path, "rb");
+	if(file == NULL) return NULL;
+
+	char *data = NULL;
+	if(fseek(file, 0, SEEK_END) != 0) goto fail;
+	const long length = ftell(file);
+	if((length < (long)HEADER_LEN) || (length > MAX_SNAPSHOT_SIZE)) goto fail;
+	rewind(file);
+
+	data = malloc(length);
+	if(data == NULL) goto fail;
+	if(fread(data, 1, length, file) != (size_t)length) goto fail;
+
+	fclose(file);
+	*size = length;
+	return data;
+
+	fail: { // As seen in CVE-2014-1266!
+		free(data);
+		fclose(file);
+		return NULL;
+	}
+}
+
+// Returns the string at *pos and moves past it, or NULL if the string is not terminated.
+static const char* next_string(const char *data, size_t size, size_t *pos) {
+	if(*pos >= size) return NULL;
+
+	const char *str = data + *pos;
+	const char *end = memchr(str, '\0', size - *pos);
+	if(end == NULL) return NULL;
+
+	*pos += (end - str) + 1;
+	return str;
+}
+
+static int parse_entry(const char *data, size_t size, size_t *pos, struct SnapshotEntry *entry) {
+	if(*pos >= size) return -1;
+	const int flags = (unsigned char)data[*pos];
+	*pos += 1;
+
+	entry->is_free = (flags & FLAG_FREE) != 0;
+	entry->name = next_string(data, size, pos);
+	entry->epoch = (flags & FLAG_HAS_EPOCH) ? next_string(data, size, pos) : NULL;
+	entry->version = next_string(data, size, pos);
+	entry->release = next_string(data, size, pos);
+	entry->arch = (flags & FLAG_HAS_ARCH) ? next_string(data, size, pos) : NULL;
+	entry->licence = next_string(data, size, pos);
+
+	if((entry->name == NULL) || (entry->version == NULL) || (entry->release == NULL) || (entry->licence == NULL)) return -1;
+	if((flags & FLAG_HAS_EPOCH) && (entry->epoch == NULL)) return -1;
+	if((flags & FLAG_HAS_ARCH) && (entry->arch == NULL)) return -1;
+	return 0;
+}
+
+static int tokenise_entry(struct Snapshot *snapshot, struct SnapshotEntry *entry, unsigned char **scratch, size_t *scratch_size) {
+	const size_t needed = TOKENISED_EVR_MAX_SIZE(
+		(entry->epoch != NULL) ? strlen(entry->epoch) : 0,
+		strlen(entry->version),
+		strlen(entry->release)
+	);
+	if(needed > *scratch_size) {
+		unsigned char *bigger = realloc(*scratch, needed);
+		if(bigger == NULL) return -1;
+
+		*scratch = bigger;
+		*scratch_size = needed;
+	}
+
+	const size_t len = versions_tokenise(entry->epoch, entry->version, entry->release, *scratch, *scratch_size);
+	if(len == 0) return -1;
+
+	entry->evr = chainbuf_appendData(&snapshot->tokens, *scratch, len);
+	return (entry->evr != NULL) ? 0 : -1;
+}
+
+struct Snapshot* snapshot_read(const char *path, int tokenise) {
+	unsigned char *scratch = NULL;
+	size_t scratch_size = 0;
+
+	struct Snapshot *snapshot = calloc(1, sizeof(struct Snapshot));
+	if(snapshot == NULL) goto fail;
+
+	size_t size;
+	snapshot->data = read_file(path, &size);
+	if(snapshot->data == NULL) goto fail;
+	if(memcmp(snapshot->data, MAGIC, MAGIC_LEN) != 0) goto fail;
+
+	const unsigned char *count_bytes = (const unsigned char*)snapshot->data + MAGIC_LEN;
+	const size_t count = ((size_t)count_bytes[0] << 24) | ((size_t)count_bytes[1] << 16) | ((size_t)count_bytes[2] << 8) | (size_t)count_bytes[3];
+	// Each entry takes up at least 5 bytes (flags + 4 empty strings), so the count can be sanity-checked.
+	if(count > (size - HEADER_LEN) / 5) goto fail;
+
+	snapshot->entries = malloc((count > 0 ? count : 1) * sizeof(struct SnapshotEntry));
+	if(snapshot->entries == NULL) goto fail;
+	if(tokenise) {
+		snapshot->tokens = chainbuf_init(16256);
+		if(snapshot->tokens == NULL) goto fail;
+	}
+
+	size_t pos = HEADER_LEN;
+	for(size_t i = 0; i < count; ++i) {
+		struct SnapshotEntry *entry = &snapshot->entries[i];
+		if(parse_entry(snapshot->data, size, &pos, entry) != 0) goto fail;
+		entry->evr = NULL;
+		if(tokenise && (tokenise_entry(snapshot, entry, &scratch, &scratch_size) != 0)) goto fail;
+		snapshot->count += 1;
+	}
+	if(pos != size) goto fail;
+
+	free(scratch);
+	return snapshot;
+
+	fail: { // As seen in CVE-2014-1266!
+		free(scratch);
+		snapshot_free(snapshot);
+		return NULL;
+	}
+}
+
+void snapshot_free(struct Snapshot *snapshot) {
+	if(snapshot == NULL) return;
+
+	if(snapshot->tokens != NULL) chainbuf_free(snapshot->tokens);
+	free(snapshot->entries);
+	free(snapshot->data);
+	free(snapshot);
+}
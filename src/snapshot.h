@@ -0,0 +1,62 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_SNAPSHOT_H
+#define VRMS_RPM_SNAPSHOT_H
+
+#include <stddef.h>
+
+/*
+ * Snapshots are compact, binary dumps of the package classification,
+ * used to compare the results of two runs (e.g. before and after rebuilding an image).
+ *
+ * The file consists of:
+ * - the magic string "VRMSSNP1"
+ * - number of entries (32-bit, big-endian)
+ * - the entries, each being a flags byte, followed by NUL-terminated strings:
+ *   name, epoch (only if present), version, release, arch (only if present), licence
+ *
+ * Entries are expected to be sorted in the same order as the package list.
+ */
+struct SnapshotEntry {
+	const char *name, *epoch, *version, *release, *arch;
+	const char *licence;
+	const unsigned char *evr; // Tokenised EVR; filled in by snapshot_read() if asked to, ignored by snapshot_append()
+	int is_free;
+};
+
+struct Snapshot {
+	struct SnapshotEntry *entries;
+	size_t count;
+
+	// The entries point into these; not to be used directly.
+	char *data;
+	struct ChainBuffer *tokens;
+};
+
+struct SnapshotWriter;
+
+extern struct SnapshotWriter* snapshot_create(const char *path, size_t count);
+extern int snapshot_append(struct SnapshotWriter *writer, const struct SnapshotEntry *entry);
+// Returns 0 if the whole snapshot has been written successfully, -1 otherwise.
+extern int snapshot_close(struct SnapshotWriter *writer);
+
+// Returns NULL if the file cannot be read or is not a valid snapshot.
+// Tokenising the EVRs is only needed for comparing entries; when not asked for, "evr" is set to NULL.
+extern struct Snapshot* snapshot_read(const char *path, int tokenise);
+extern void snapshot_free(struct Snapshot *snapshot);
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "src/sort.h"
+
+#define MAX_THREADS 16
+
+struct SortTask {
+	char *base;
+	size_t count;
+	size_t size;
+	sort_compare_func compare;
+};
+
+struct MergeTask {
+	const char *left, *right;
+	size_t left_count, right_count;
+	char *out;
+	size_t size;
+	sort_compare_func compare;
+};
+
+static void* sort_task(void *arg) {
+	struct SortTask *task = arg;
+	qsort(task->base, task->count, task->size, task->compare);
+	return NULL;
+}
+
+// Merge two sorted runs. When elements compare equal, the one from the left run goes first.
+static void* merge_task(void *arg) {
+	struct MergeTask *task = arg;
+	const char *left = task->left, *right = task->right;
+	const char *const left_end = left + (task->left_count * task->size);
+	const char *const right_end = right + (task->right_count * task->size);
+	char *out = task->out;
+
+	while((left < left_end) && (right < right_end)) {
+		if(task->compare(left, right) <= 0) {
+			memcpy(out, left, task->size);
+			left += task->size;
+		} else {
+			memcpy(out, right, task->size);
+			right += task->size;
+		}
+		out += task->size;
+	}
+
+	if(left < left_end) memcpy(out, left, left_end - left);
+	out += (left_end - left);
+	if(right < right_end) memcpy(out, right, right_end - right);
+
+	return NULL;
+}
+
+// Run all the tasks, each in a separate thread. If a thread cannot be started,
+// run its task in the calling thread instead.
+static void run_tasks(void*(*func)(void*), void *tasks, size_t task_size, unsigned int count) {
+	pthread_t thread[MAX_THREADS];
+	int started[MAX_THREADS];
+
+	for(unsigned int t = 1; t < count; ++t) {
+		void *task = (char*)tasks + (t * task_size);
+		started[t] = (pthread_create(&thread[t], NULL, func, task) == 0);
+		if(!started[t]) func(task);
+	}
+	func(tasks);
+
+	for(unsigned int t = 1; t < count; ++t) {
+		if(started[t]) pthread_join(thread[t], NULL);
+	}
+}
+
+int sort_parallel(void *base, size_t count, size_t size, sort_compare_func compare, unsigned int threads) {
+	if(threads > MAX_THREADS) threads = MAX_THREADS;
+	if(threads > count) threads = count;
+	if(threads <= 1) {
+		qsort(base, count, size, compare);
+		return 0;
+	}
+
+	char *temp = malloc(count * size);
+	if(temp == NULL) {
+		qsort(base, count, size, compare);
+		return -1;
+	}
+
+	// Split the array into chunks of (almost) equal size and sort them.
+	size_t run_start[MAX_THREADS + 1];
+	struct SortTask sort_tasks[MAX_THREADS];
+	for(unsigned int t = 0; t <= threads; ++t) run_start[t] = (count * t) / threads;
+	for(unsigned int t = 0; t < threads; ++t) {
+		sort_tasks[t] = (struct SortTask){
+			.base = (char*)base + (run_start[t] * size),
+			.count = run_start[t+1] - run_start[t],
+			.size = size,
+			.compare = compare,
+		};
+	}
+	run_tasks(&sort_task, sort_tasks, sizeof(struct SortTask), threads);
+
+	// Merge adjacent runs, pair by pair, until only one is left.
+	// Each round halves the number of runs and moves the data between the two buffers.
+	char *src = base, *dst = temp;
+	unsigned int runs = threads;
+	while(runs > 1) {
+		struct MergeTask merge_tasks[MAX_THREADS / 2 + 1];
+		unsigned int tasks = 0;
+
+		for(unsigned int r = 0; r < runs; r += 2) {
+			const size_t left = run_start[r];
+			const size_t middle = run_start[(r + 1 < runs) ? (r + 1) : runs];
+			const size_t right = run_start[(r + 2 < runs) ? (r + 2) : runs];
+			merge_tasks[tasks++] = (struct MergeTask){
+				.left = src + (left * size),
+				.left_count = middle - left,
+				.right = src + (middle * size),
+				.right_count = right - middle,
+				.out = dst + (left * size),
+				.size = size,
+				.compare = compare,
+			};
+		}
+		run_tasks(&merge_task, merge_tasks, sizeof(struct MergeTask), tasks);
+
+		for(unsigned int r = 0; r < tasks; ++r) run_start[r] = run_start[r * 2];
+		run_start[tasks] = count;
+		runs = tasks;
+
+		char *swap = src;
+		src = dst;
+		dst = swap;
+	}
+
+	if(src != base) memcpy(base, src, count * size);
+	free(temp);
+	return 0;
+}
+
+unsigned int sort_threadCount(void) {
+	const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if(cpus < 1) return 1;
+	if(cpus > MAX_THREADS) return MAX_THREADS;
+	return cpus;
+}
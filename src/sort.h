@@ -0,0 +1,40 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_SORT_H
+#define VRMS_RPM_SORT_H
+
+#include <stddef.h>
+
+typedef int(*sort_compare_func)(const void*, const void*);
+
+/*
+ * Sort the array using multiple threads. The array is split into chunks,
+ * each chunk is sorted with qsort(), and then the chunks are merged.
+ *
+ * Since qsort() is not stable, the result is identical to that of a plain
+ * qsort() call only if the comparison function never reports two distinct
+ * elements as equal.
+ *
+ * Returns 0 on success, or -1 if the temporary buffer could not be allocated
+ * (in which case the array is sorted using a single thread).
+ */
+extern int sort_parallel(void *base, size_t count, size_t size, sort_compare_func compare, unsigned int threads);
+
+// Number of threads worth using, based on the number of available CPUs.
+extern unsigned int sort_threadCount(void);
+
+#endif
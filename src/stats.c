@@ -0,0 +1,124 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "src/stats.h"
+
+#define GENERATE_STRING(what, name) name,
+static const char *const phasename[] = {
+	FOREACH_STATS_PHASE(GENERATE_STRING)
+};
+static const char *const countername[] = {
+	FOREACH_STATS_COUNTER(GENERATE_STRING)
+};
+#undef GENERATE_STRING
+
+struct PhaseTimes {
+	struct timespec wall_start, cpu_start;
+	double wall_ms, cpu_ms;
+	int used;
+};
+
+static struct PhaseTimes phase_times[STATS_PHASE_COUNT];
+
+_Atomic unsigned long stats_counter[STATS_COUNTER_COUNT];
+
+void stats_raise(enum StatsCounter counter, unsigned long value) {
+	unsigned long current = atomic_load_explicit(&stats_counter[counter], memory_order_relaxed);
+	while(value > current) {
+		if(atomic_compare_exchange_weak_explicit(&stats_counter[counter], &current, value, memory_order_relaxed, memory_order_relaxed)) break;
+	}
+}
+
+void stats_chainbufAlloc(size_t bytes) {
+	const unsigned long total = atomic_fetch_add_explicit(&stats_counter[STATS_COUNTER_CHAINBUF_BYTES], bytes, memory_order_relaxed) + bytes;
+	stats_raise(STATS_COUNTER_CHAINBUF_PEAK_BYTES, total);
+}
+
+void stats_chainbufFree(size_t bytes) {
+	atomic_fetch_sub_explicit(&stats_counter[STATS_COUNTER_CHAINBUF_BYTES], bytes, memory_order_relaxed);
+}
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end) {
+	return ((end->tv_sec - start->tv_sec) * 1000.0) + ((end->tv_nsec - start->tv_nsec) / 1000000.0);
+}
+
+void stats_begin(enum StatsPhase phase) {
+	clock_gettime(CLOCK_MONOTONIC, &phase_times[phase].wall_start);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &phase_times[phase].cpu_start);
+}
+
+// Phases can be entered multiple times - in such case, the times are summed.
+void stats_end(enum StatsPhase phase) {
+	struct timespec wall_end, cpu_end;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+	clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+	struct PhaseTimes *pt = &phase_times[phase];
+	pt->wall_ms += elapsed_ms(&pt->wall_start, &wall_end);
+	pt->cpu_ms += elapsed_ms(&pt->cpu_start, &cpu_end);
+	pt->used = 1;
+}
+
+static void print_text(FILE *file) {
+	fprintf(file, "%-24s %12s %12s\n", "phase", "wall (ms)", "cpu (ms)");
+	for(int p = 0; p < STATS_PHASE_COUNT; ++p) {
+		if(!phase_times[p].used) continue;
+		fprintf(file, "%-24s %12.3f %12.3f\n", phasename[p], phase_times[p].wall_ms, phase_times[p].cpu_ms);
+	}
+
+	fprintf(file, "\n%-24s %12s\n", "counter", "value");
+	for(int c = 0; c < STATS_COUNTER_COUNT; ++c) {
+		fprintf(file, "%-24s %12lu\n", countername[c], atomic_load_explicit(&stats_counter[c], memory_order_relaxed));
+	}
+}
+
+// The locale may use a decimal comma, which is not valid JSON, so the fraction is formatted by hand.
+static void print_json_ms(FILE *file, const double ms) {
+	const unsigned long us = (unsigned long)((ms * 1000.0) + 0.5);
+	fprintf(file, "%lu.%03lu", us / 1000, us % 1000);
+}
+
+static void print_json(FILE *file) {
+	fputs("{\"phases\":{", file);
+	const char *separator = "";
+	for(int p = 0; p < STATS_PHASE_COUNT; ++p) {
+		if(!phase_times[p].used) continue;
+		fprintf(file, "%s\"%s\":{\"wall_ms\":", separator, phasename[p]);
+		print_json_ms(file, phase_times[p].wall_ms);
+		fputs(",\"cpu_ms\":", file);
+		print_json_ms(file, phase_times[p].cpu_ms);
+		putc('}', file);
+		separator = ",";
+	}
+
+	fputs("},\"counters\":{", file);
+	separator = "";
+	for(int c = 0; c < STATS_COUNTER_COUNT; ++c) {
+		fprintf(file, "%s\"%s\":%lu", separator, countername[c], atomic_load_explicit(&stats_counter[c], memory_order_relaxed));
+		separator = ",";
+	}
+	fputs("}}\n", file);
+}
+
+void stats_print(FILE *file, int json) {
+	if(json)
+		print_json(file);
+	else
+		print_text(file);
+}
@@ -0,0 +1,86 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VRMS_RPM_STATS_H
+#define VRMS_RPM_STATS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define FOREACH_STATS_PHASE(PHASE)                          \
+	PHASE(LANG_INIT,      "lang_init")                      \
+	PHASE(OPTIONS_PARSE,  "options_parse")                  \
+	PHASE(OPEN_PIPE,      "packages_openPipe")              \
+	PHASE(LICENCES_READ,  "licences_read")                  \
+	PHASE(CLASSIFIER_NEW, "classifier_new")                 \
+	PHASE(PACKAGES_READ,  "packages_read")                  \
+	PHASE(READ_WAIT,      "packages_read/wait")             \
+	PHASE(READ_PARSE,     "packages_read/parse")            \
+	PHASE(READ_CLASSIFY,  "packages_read/classify")         \
+	PHASE(PACKAGES_SORT,  "packages_sort")                  \
+	PHASE(PACKAGES_LIST,  "packages_list")                  \
+	PHASE(AGGREGATE,      "aggregate")                      \
+
+#define FOREACH_STATS_COUNTER(COUNTER)                      \
+	COUNTER(LINES_READ,          "lines_read")              \
+	COUNTER(LINES_REJECTED,      "lines_rejected")          \
+	COUNTER(CLASSIFIER_CALLS,    "classifier_calls")        \
+	COUNTER(LICENCES_FIND_CALLS, "licences_find_calls")     \
+	COUNTER(TREE_NODE_MALLOCS,   "tree_node_mallocs")       \
+	COUNTER(CLASSIFIER_DEPTH,    "classifier_max_depth")    \
+	COUNTER(CHAINBUF_BYTES,      "chainbuf_bytes")          \
+	COUNTER(CHAINBUF_PEAK_BYTES, "chainbuf_peak_bytes")     \
+	COUNTER(HEADER_BYTES_READ,   "header_bytes_read")       \
+
+
+#define GENERATE_ENUM(what, name) STATS_PHASE_ ## what,
+enum StatsPhase {
+	FOREACH_STATS_PHASE(GENERATE_ENUM)
+	STATS_PHASE_COUNT
+};
+#undef GENERATE_ENUM
+
+#define GENERATE_ENUM(what, name) STATS_COUNTER_ ## what,
+enum StatsCounter {
+	FOREACH_STATS_COUNTER(GENERATE_ENUM)
+	STATS_COUNTER_COUNT
+};
+#undef GENERATE_ENUM
+
+
+extern _Atomic unsigned long stats_counter[STATS_COUNTER_COUNT];
+
+// Counters are bumped unconditionally - a single increment
+// is cheaper than checking whether stats were requested.
+// Some of them are bumped from worker threads, hence the atomics; relaxed
+// ordering is enough, as the values are only read once the workers are done.
+#define stats_count(what)  atomic_fetch_add_explicit(&stats_counter[STATS_COUNTER_ ## what], 1, memory_order_relaxed)
+
+#define stats_add(what, value)  atomic_fetch_add_explicit(&stats_counter[STATS_COUNTER_ ## what], (value), memory_order_relaxed)
+
+#define stats_max(what, value)  stats_raise(STATS_COUNTER_ ## what, (value))
+
+extern void stats_raise(enum StatsCounter counter, unsigned long value);
+extern void stats_chainbufAlloc(size_t bytes);
+extern void stats_chainbufFree(size_t bytes);
+
+extern void stats_begin(enum StatsPhase phase);
+extern void stats_end(enum StatsPhase phase);
+
+extern void stats_print(FILE *file, int json);
+
+#endif
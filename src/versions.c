@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2021, 2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2021, 2023-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -15,17 +15,15 @@
  * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "src/stringutils.h"
 #include "src/versions.h"
 
 #ifdef WITH_LIBRPM
 #include <rpm/rpmio.h>
 #include <rpm/rpmlib.h>
-
-#else
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+#endif
 
 /*
  * The ordering here may seem rather weird, but it follows the RPM version logic.
@@ -53,7 +51,7 @@
  *
  * When you combine the rules above, the weird ordering we have in this enum
  * allows for implementing said rules in a simple "if(a>b) else if(a<b)" manner,
- * as seen later in the code in fallback_compare().
+ * as seen later in the code in compare_versions_fallback().
  */
 enum VersionComponentType {
 	VCT_TILDE,  // Component preceded by '~'
@@ -62,13 +60,14 @@ enum VersionComponentType {
 	VCT_NORMAL, // Component preceded by '.'
 };
 
-#define COMPBUF_LEN 64
-
+// Components are not copied anywhere - the parser only points at them
+// inside the original string, so there's no limit on their length.
 struct VersionParser {
 	const char *current;
 	char previous;
 	enum VersionComponentType type;
-	char data[COMPBUF_LEN];
+	const char *data;
+	size_t len;
 };
 
 static void parser_init(const char *source, struct VersionParser *out) {
@@ -98,9 +97,8 @@ static void parser_advance(struct VersionParser *vp) {
 		++component_len;
 	}
 
-	if(component_len >= (COMPBUF_LEN - 1)) component_len = (COMPBUF_LEN - 1);
-	memcpy(vp->data, vp->current, component_len);
-	vp->data[component_len] = '\0';
+	vp->data = vp->current;
+	vp->len = component_len;
 
 	if(vp->previous == '^')
 		vp->type = VCT_CARET;
@@ -113,13 +111,37 @@ static void parser_advance(struct VersionParser *vp) {
 	vp->previous = c;
 }
 
-static int str_to_int(const char *str, long *result) {
-	char *badchar;
-	*result = strtol(str, &badchar, 10);
-	return (badchar != NULL) && (*badchar == '\0');
+// An empty component is considered numeric, with a value of zero.
+static int is_numeric(const char *str, size_t len) {
+	for(size_t i = 0; i < len; ++i) {
+		if((str[i] < '0') || (str[i] > '9')) return 0;
+	}
+	return 1;
+}
+
+static int compare_numeric(const char *a, size_t a_len, const char *b, size_t b_len) {
+	while((a_len > 0) && (*a == '0')) { ++a; --a_len; }
+	while((b_len > 0) && (*b == '0')) { ++b; --b_len; }
+
+	// With leading zeroes out of the way, the longer number is the greater one.
+	// For numbers of equal length, comparing the digits lexically does the job.
+	if(a_len > b_len) return +1;
+	if(a_len < b_len) return -1;
+
+	const int result = memcmp(a, b, a_len);
+	return (result > 0) - (result < 0);
+}
+
+static int compare_alpha(const char *a, size_t a_len, const char *b, size_t b_len) {
+	const int result = memcmp(a, b, (a_len < b_len) ? a_len : b_len);
+	if(result != 0) return (result > 0) - (result < 0);
+
+	if(a_len > b_len) return +1;
+	if(a_len < b_len) return -1;
+	return 0;
 }
 
-static int fallback_compare(const char *a, const char *b) {
+int compare_versions_fallback(const char *a, const char *b) {
 	struct VersionParser comp_a, comp_b;
 	parser_init(a, &comp_a);
 	parser_init(b, &comp_b);
@@ -132,28 +154,177 @@ static int fallback_compare(const char *a, const char *b) {
 		if(comp_a.type > comp_b.type) return +1;
 		if(comp_a.type == VCT_EXHAUSTED) return 0;
 
-		// Attempt to convert the segments to integers.
-		// If this succeeds, compare their numerical values.
-		long int a_int, b_int;
-		const int a_is_int = str_to_int(comp_a.data, &a_int);
-		const int b_is_int = str_to_int(comp_b.data, &b_int);
-		if(a_is_int && b_is_int) {
-			if(a_int > b_int) return +1;
-			if(a_int < b_int) return -1;
+		// If both segments are numbers, compare their numerical values.
+		// Otherwise, compare them as strings.
+		int result;
+		if(is_numeric(comp_a.data, comp_a.len) && is_numeric(comp_b.data, comp_b.len))
+			result = compare_numeric(comp_a.data, comp_a.len, comp_b.data, comp_b.len);
+		else
+			result = compare_alpha(comp_a.data, comp_a.len, comp_b.data, comp_b.len);
+
+		if(result != 0) return result;
+	}
+}
+
+/*
+ * Tokenised EVRs follow the rules used by rpmvercmp():
+ * - The string is split into alphabetic and numeric segments.
+ * - Any other characters, save for '~' and '^', are separators and are ignored.
+ * - When comparing numeric segments, leading zeroes are ignored.
+ * - Numeric segments are considered newer than alphabetic ones.
+ *
+ * Each token is a single byte. Segment tokens are followed by two bytes
+ * holding the segment length (big-endian), and then by the segment itself.
+ * For numeric segments, leading zeroes are dropped during tokenisation.
+ *
+ * The EVR is stored as a flag byte telling whether the package has an epoch,
+ * followed by the epoch, version and release, each one terminated by TOKEN_END.
+ */
+enum VersionToken {
+	TOKEN_END,
+	TOKEN_TILDE,
+	TOKEN_CARET,
+	TOKEN_NUMERIC,
+	TOKEN_ALPHA,
+};
+
+#define SEGMENT_MAX_LEN 0xFFFF
+
+static int is_digit(const char c) {
+	return (c >= '0') && (c <= '9');
+}
+
+static int is_alpha(const char c) {
+	return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'));
+}
+
+static unsigned char* tokenise(const char *str, unsigned char *out, const unsigned char *const out_end) {
+	while(*str != '\0') {
+		if((*str == '~') || (*str == '^')) {
+			if(out == out_end) return NULL;
+			*(out++) = (*str == '~') ? TOKEN_TILDE : TOKEN_CARET;
+			++str;
+			continue;
+		}
+
+		int(*const check)(const char) = is_digit(*str) ? &is_digit : is_alpha(*str) ? &is_alpha : NULL;
+		if(check == NULL) {
+			++str;
 			continue;
 		}
 
-		// If segments are not ints, compare them as strings.
-		const int compare_strings = strcmp(comp_a.data, comp_b.data);
-		if(compare_strings != 0) return compare_strings;
+		const char *start = str;
+		while(check(*str)) ++str;
+
+		unsigned char type = TOKEN_ALPHA;
+		if(check == &is_digit) {
+			type = TOKEN_NUMERIC;
+			while((start < str) && (*start == '0')) ++start;
+		}
+
+		const size_t len = str - start;
+		if((len > SEGMENT_MAX_LEN) || ((size_t)(out_end - out) < (len + 3))) return NULL;
+
+		*(out++) = type;
+		*(out++) = (len >> 8) & 0xFF;
+		*(out++) = len & 0xFF;
+		memcpy(out, start, len);
+		out += len;
 	}
+
+	if(out == out_end) return NULL;
+	*(out++) = TOKEN_END;
+	return out;
+}
+
+size_t versions_tokenise(const char *epoch, const char *version, const char *release, unsigned char *buffer, size_t bufsize) {
+	if(bufsize == 0) return 0;
+
+	const unsigned char *const buffer_end = buffer + bufsize;
+	unsigned char *out = buffer;
+	*(out++) = (epoch != NULL);
+
+	const char *parts[] = { (epoch != NULL) ? epoch : "", version, release };
+	for(unsigned int p = 0; p < sizeof(parts) / sizeof(parts[0]); ++p) {
+		out = tokenise(parts[p], out, buffer_end);
+		if(out == NULL) return 0;
+	}
+
+	return out - buffer;
+}
+
+static size_t segment_len(const unsigned char *token) {
+	return ((size_t)token[1] << 8) | token[2];
+}
+
+// Compare a single part (epoch, version or release) of the EVR.
+static int compare_tokens(const unsigned char **A, const unsigned char **B) {
+	const unsigned char *a = *A;
+	const unsigned char *b = *B;
+	int result = 0;
+
+	for(;;) {
+		if((*a == TOKEN_TILDE) || (*b == TOKEN_TILDE)) {
+			if(*a != TOKEN_TILDE) { result = +1; break; }
+			if(*b != TOKEN_TILDE) { result = -1; break; }
+			++a, ++b;
+			continue;
+		}
+
+		if((*a == TOKEN_CARET) || (*b == TOKEN_CARET)) {
+			if(*a == TOKEN_END) { result = -1; break; }
+			if(*b == TOKEN_END) { result = +1; break; }
+			if(*a != TOKEN_CARET) { result = +1; break; }
+			if(*b != TOKEN_CARET) { result = -1; break; }
+			++a, ++b;
+			continue;
+		}
+
+		if((*a == TOKEN_END) || (*b == TOKEN_END)) {
+			result = (*a != TOKEN_END) - (*b != TOKEN_END);
+			break;
+		}
+
+		if(*a != *b) {
+			result = (*a == TOKEN_NUMERIC) ? +1 : -1;
+			break;
+		}
+
+		const size_t a_len = segment_len(a);
+		const size_t b_len = segment_len(b);
+		if(*a == TOKEN_NUMERIC)
+			result = compare_numeric((const char*)a + 3, a_len, (const char*)b + 3, b_len);
+		else
+			result = compare_alpha((const char*)a + 3, a_len, (const char*)b + 3, b_len);
+		if(result != 0) break;
+
+		a += 3 + a_len;
+		b += 3 + b_len;
+	}
+
+	// When the parts are equal, both pointers are at TOKEN_END. Move past it,
+	// so the caller can continue with the next part of the EVR.
+	*A = a + 1;
+	*B = b + 1;
+	return result;
+}
+
+int versions_compareTokens(const unsigned char *a, const unsigned char *b) {
+	// Packages without an epoch go before those with one.
+	if(*a != *b) return (*a > *b) ? +1 : -1;
+	++a, ++b;
+
+	for(int part = 0; part < 3; ++part) {
+		const int result = compare_tokens(&a, &b);
+		if(result != 0) return result;
+	}
+	return 0;
 }
-#endif
 
 int compare_versions(const char *a, const char *b) {
 	#ifdef WITH_LIBRPM
 		return str_compare_with_null_check(a, b, &rpmvercmp);
 	#else
-		return str_compare_with_null_check(a, b, &fallback_compare);
+		return str_compare_with_null_check(a, b, &compare_versions_fallback);
 	#endif
 }
@@ -18,6 +18,31 @@
 #ifndef VRMS_RPM_VERSIONS_H
 #define VRMS_RPM_VERSIONS_H
 
+#include <stddef.h>
+
+// Compare two version strings using rpmvercmp() when built with librpm, or the fallback otherwise.
+// Package lists are sorted with this only in librpm builds; without librpm, they use the tokens below.
 extern int compare_versions(const char *a, const char *b);
 
+// The string comparison function used when building without librpm.
+// Always available, so it can be tested and benchmarked against rpmvercmp().
+extern int compare_versions_fallback(const char *a, const char *b);
+
+/*
+ * Convert the epoch, version and release into a sequence of tokens,
+ * which can later be compared without having to parse the strings again.
+ * The epoch can be NULL; such a package sorts before any package with an epoch.
+ *
+ * Returns the size of the tokenised EVR, or 0 if it does not fit in the buffer.
+ * TOKENISED_EVR_MAX_SIZE() gives a buffer size that is always large enough -
+ * the worst case are alternating letters and digits, where every character
+ * becomes a separate segment with a 3-byte header.
+ */
+extern size_t versions_tokenise(const char *epoch, const char *version, const char *release, unsigned char *buffer, size_t bufsize);
+
+#define TOKENISED_EVR_MAX_SIZE(epoch_len, version_len, release_len)  (4 * ((epoch_len) + (version_len) + (release_len)) + 16)
+
+// Compare two tokenised EVRs. This follows the logic of rpmvercmp().
+extern int versions_compareTokens(const unsigned char *a, const unsigned char *b);
+
 #endif
@@ -1,6 +1,6 @@
 /**
  * vrms-rpm - list non-free packages on an rpm-based Linux distribution
- * Copyright (C) 2018, 2023 suve (a.k.a. Artur Frenszek-Iwicki)
+ * Copyright (C) 2018, 2023-2024 suve (a.k.a. Artur Frenszek-Iwicki)
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 3,
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#include "src/aggregate.h"
 #include "src/classifiers.h"
 #include "src/fileutils.h"
 #include "src/lang.h"
@@ -24,6 +25,13 @@
 #include "src/options.h"
 #include "src/packages.h"
 #include "src/pipes.h"
+#include "src/repodata.h"
+#include "src/rpmdb.h"
+#include "src/sort.h"
+#include "src/stats.h"
+
+// Used by --fail-on-nonfree, so scripts can tell "too many non-free packages" apart from errors.
+#define EXIT_NONFREE  2
 
 static void easteregg(void) {
 	int free, nonfree;
@@ -43,50 +51,194 @@ static void easteregg(void) {
 	}
 }
 
-static struct LicenceClassifier* allocClassifier(const struct LicenceData *data) {
+static int threshold_reached(void) {
+	int free, nonfree;
+	packages_getcount(&free, &nonfree);
+
+	if(opt_failonnonfree == OPT_FAIL_PERCENT) {
+		const long total = (long)free + nonfree;
+		return (total > 0) && ((100L * nonfree) >= ((long)opt_failthreshold * total));
+	}
+	return nonfree >= opt_failthreshold;
+}
+
+static struct LicenceClassifier* allocClassifier(const struct LicenceData *const *data, unsigned int count) {
 	switch(opt_grammar) {
 		case OPT_GRAMMAR_LOOSE:
-			return classifier_newLoose(data);
+			return classifier_newLoose(data, count);
 		case OPT_GRAMMAR_SPDX_STRICT:
-			return classifier_newSPDX(data, 0);
+			return classifier_newSPDX(data, count, 0);
 		case OPT_GRAMMAR_SPDX_LENIENT:
-			return classifier_newSPDX(data, 1);
+			return classifier_newSPDX(data, count, 1);
 		default:
 			return NULL; // Should Never Happen (TM)
 	}
 }
 
 int main(int argc, char *argv[]) {
-	lang_init();
+	lang_setLocale();
+
+	// We don't know yet whether the user wants the stats or not,
+	// so option parsing has to be timed unconditionally.
+	// Translations are loaded lazily, when the first message is printed.
+	stats_begin(STATS_PHASE_OPTIONS_PARSE);
 	options_parse(argc, argv);
+	stats_end(STATS_PHASE_OPTIONS_PARSE);
+
+	if(opt_aggregate) {
+		stats_begin(STATS_PHASE_AGGREGATE);
+		const int result = (opt_filecount > 0)
+			? aggregate_snapshots(opt_files, opt_filecount, sort_threadCount())
+			: aggregate_snapshotList(stdin, sort_threadCount());
+		stats_end(STATS_PHASE_AGGREGATE);
+		if(result < 0) {
+			lang_fprint(stderr, MSG_ERR_AGGREGATE_FAILED);
+			exit(EXIT_FAILURE);
+		}
+
+		if(opt_stats != OPT_STATS_NONE) stats_print(stderr, opt_stats == OPT_STATS_JSON);
+		return 0;
+	}
 	
-	struct Pipe *rpmpipe = packages_openPipe();
-	if(rpmpipe == NULL) {
-		lang_fprint(stderr, MSG_ERR_PIPE_OPEN_FAILED);
-		exit(EXIT_FAILURE);
+	// Without rpm installed, fall back to reading the database directly.
+	const char *rpmdb = opt_rpmdb;
+	if((opt_repodata == NULL) && (rpmdb == NULL) && !packages_canOpenPipe()) {
+		rpmdb = rpmdb_defaultPath();
+		if(rpmdb == NULL) {
+			lang_fprint(stderr, MSG_ERR_PIPE_OPEN_FAILED);
+			exit(EXIT_FAILURE);
+		}
 	}
 
-	struct LicenceData *licenses = licences_read();
-	if(licenses == NULL) {
-		lang_fprint(stderr, MSG_ERR_LICENCES_FAILED);
-		exit(EXIT_FAILURE);
+	// Start rpm as early as possible, so it can do its work while we're busy setting up.
+	struct Pipe *rpmpipe = NULL;
+	if((opt_repodata == NULL) && (rpmdb == NULL)) {
+		stats_begin(STATS_PHASE_OPEN_PIPE);
+		rpmpipe = packages_openPipe();
+		stats_end(STATS_PHASE_OPEN_PIPE);
+		if(rpmpipe == NULL) {
+			lang_fprint(stderr, MSG_ERR_PIPE_OPEN_FAILED);
+			exit(EXIT_FAILURE);
+		}
 	}
-	struct LicenceClassifier *classifier = allocClassifier(licenses);
+
+	stats_begin(STATS_PHASE_LICENCES_READ);
+	struct LicenceData *licenses[LICENCE_LISTS_MAX];
+	for(int i = 0; i < opt_licencelistcount; ++i) {
+		licenses[i] = licences_read(opt_licencelist[i]);
+		if(licenses[i] == NULL) {
+			lang_fprint(stderr, MSG_ERR_LICENCES_FAILED);
+			exit(EXIT_FAILURE);
+		}
+	}
+	stats_end(STATS_PHASE_LICENCES_READ);
+
+	stats_begin(STATS_PHASE_CLASSIFIER_NEW);
+	struct LicenceClassifier *classifier = allocClassifier((const struct LicenceData *const *)licenses, opt_licencelistcount);
+	stats_end(STATS_PHASE_CLASSIFIER_NEW);
 	if(classifier == NULL) {
 		lang_fprint(stderr, MSG_ERR_MALLOC);
 		exit(EXIT_FAILURE);
 	}
 	
-	if(packages_read(rpmpipe, classifier) < 0) {
-		lang_fprint(stderr, MSG_ERR_PIPE_READ_FAILED);
-		exit(EXIT_FAILURE);
+	if(rpmpipe != NULL) {
+		stats_begin(STATS_PHASE_PACKAGES_READ);
+		const int read_result = packages_read(rpmpipe, classifier);
+		const int pipe_result = pipe_destroy(rpmpipe);
+		stats_end(STATS_PHASE_PACKAGES_READ);
+		// When rpm gets killed, the read itself might look successful - just cut short.
+		if(pipe_result == PIPE_CHILD_TIMEOUT) {
+			lang_fprint(stderr, MSG_ERR_PIPE_TIMEOUT, opt_rpmtimeout);
+			exit(EXIT_FAILURE);
+		}
+		if(read_result < 0) {
+			lang_fprint(stderr, MSG_ERR_PIPE_READ_FAILED);
+			exit(EXIT_FAILURE);
+		}
+		if(pipe_result != PIPE_CHILD_OK) {
+			lang_fprint(stderr, MSG_ERR_PIPE_CHILD_FAILED);
+			exit(EXIT_FAILURE);
+		}
+	} else if(opt_repodata != NULL) {
+		stats_begin(STATS_PHASE_PACKAGES_READ);
+		const int read_result = repodata_read(opt_repodata, classifier);
+		stats_end(STATS_PHASE_PACKAGES_READ);
+		if(read_result < 0) {
+			enum MessageID error = MSG_ERR_REPODATA_READ_FAILED;
+			if(read_result == REPODATA_OPEN_FAILED) error = MSG_ERR_REPODATA_OPEN_FAILED;
+			if(read_result == REPODATA_UNSUPPORTED) error = MSG_ERR_REPODATA_UNSUPPORTED;
+
+			lang_fprint(stderr, error, opt_repodata);
+			exit(EXIT_FAILURE);
+		}
+	} else {
+		stats_begin(STATS_PHASE_PACKAGES_READ);
+		const int read_result = rpmdb_read(rpmdb, classifier);
+		stats_end(STATS_PHASE_PACKAGES_READ);
+		if(read_result < 0) {
+			enum MessageID error = MSG_ERR_RPMDB_READ_FAILED;
+			if(read_result == RPMDB_OPEN_FAILED) error = MSG_ERR_RPMDB_OPEN_FAILED;
+			if(read_result == RPMDB_UNSUPPORTED) error = MSG_ERR_RPMDB_UNSUPPORTED;
+
+			lang_fprint(stderr, error, rpmdb);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if(opt_failonnonfree != OPT_FAIL_NEVER) {
+		const int reached = threshold_reached();
+		if(reached) {
+			char threshold[16];
+			snprintf(threshold, sizeof(threshold), (opt_failonnonfree == OPT_FAIL_PERCENT) ? "%d%%" : "%d", opt_failthreshold);
+			lang_print(MSG_NONFREE_THRESHOLD_REACHED, threshold);
+		} else {
+			// Nothing was stored, so only the counts can be printed.
+			stats_begin(STATS_PHASE_PACKAGES_LIST);
+			packages_list();
+			stats_end(STATS_PHASE_PACKAGES_LIST);
+		}
+
+		packages_free();
+		classifier->free(classifier);
+		for(int i = 0; i < opt_licencelistcount; ++i) licences_free(licenses[i]);
+
+		if(opt_stats != OPT_STATS_NONE) stats_print(stderr, opt_stats == OPT_STATS_JSON);
+		return reached ? EXIT_NONFREE : 0;
 	}
 	
-	packages_list();
-	easteregg();
+	if(packages_needSort()) {
+		stats_begin(STATS_PHASE_PACKAGES_SORT);
+		packages_sort();
+		stats_end(STATS_PHASE_PACKAGES_SORT);
+	}
+
+	if(opt_diffagainst != NULL) {
+		stats_begin(STATS_PHASE_PACKAGES_LIST);
+		const int diff_result = packages_diffSnapshot(opt_diffagainst);
+		stats_end(STATS_PHASE_PACKAGES_LIST);
+		if(diff_result < 0) {
+			lang_fprint(stderr, MSG_ERR_SNAPSHOT_READ_FAILED, opt_diffagainst);
+			exit(EXIT_FAILURE);
+		}
+	} else {
+		stats_begin(STATS_PHASE_PACKAGES_LIST);
+		packages_list();
+		stats_end(STATS_PHASE_PACKAGES_LIST);
+		easteregg();
+	}
+
+	// Done after diffing, so the same file can be used for both.
+	if(opt_savesnapshot != NULL) {
+		if(packages_saveSnapshot(opt_savesnapshot) != 0) {
+			lang_fprint(stderr, MSG_ERR_SNAPSHOT_WRITE_FAILED, opt_savesnapshot);
+			exit(EXIT_FAILURE);
+		}
+	}
 	
 	packages_free();
 	classifier->free(classifier);
-	licences_free(licenses);
+	for(int i = 0; i < opt_licencelistcount; ++i) licences_free(licenses[i]);
+
+	if(opt_stats != OPT_STATS_NONE) stats_print(stderr, opt_stats == OPT_STATS_JSON);
 	return 0;
 }
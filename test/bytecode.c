@@ -0,0 +1,126 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "src/buffers.h"
+#include "src/bytecode.h"
+#include "src/options.h"
+#include "test/licences.h"
+
+// Classify the text, encode the tree and check the results of all the evaluators.
+static void test_code(struct LicenceClassifier *classifier, const char *text, int is_free, const char *explain, const char *json) {
+	char base[256], work[256];
+	strcpy(base, text);
+	strcpy(work, text);
+
+	struct LicenceTreeNode *tree = classifier->classify(classifier, work);
+	assert_non_null(tree);
+
+	struct ReBuffer *buf = rebuf_init(64);
+	assert_non_null(buf);
+	assert_int_equal(bytecode_encode(tree, work, buf), 0);
+	licence_freeTree(tree);
+
+	// The code does not point into the string it was built from,
+	// so the classifier's scratch copy can be thrown away.
+	memset(work, '\0', sizeof(work));
+
+	const unsigned char *code = buf->data;
+	assert_int_equal(bytecode_size(code), buf->used);
+	assert_int_equal(bytecode_isFree(code), is_free);
+
+	char output[512];
+	FILE *file = tmpfile();
+	assert_non_null(file);
+
+	assert_int_equal(bytecode_print(file, code, base), 0);
+	rewind(file);
+	size_t len = fread(output, 1, sizeof(output) - 1, file);
+	output[len] = '\0';
+	assert_string_equal(output, explain);
+
+	rewind(file);
+	assert_int_equal(bytecode_printJSON(file, code, base), 0);
+	const long json_len = ftell(file);
+	rewind(file);
+	len = fread(output, 1, json_len, file);
+	output[len] = '\0';
+	assert_string_equal(output, json);
+
+	fclose(file);
+	rebuf_free(buf);
+}
+
+void test__bytecode(void **state) {
+	struct LicenceClassifier *classifier = ((struct TestState*)*state)->spdxStrictClassifier;
+
+	const int old_colour = opt_colour;
+	const int old_grammar = opt_grammar;
+	opt_colour = 0;
+	opt_grammar = OPT_GRAMMAR_SPDX_STRICT;
+
+	test_code(classifier, "Good", 1, "Good", "{\"licence\":\"Good\",\"free\":true}");
+	test_code(classifier, "Bad \"quoted\"", 0, "Bad \"quoted\"", "{\"licence\":\"Bad \\\"quoted\\\"\",\"free\":false}");
+
+	test_code(
+		classifier, "Good AND Bad", 0,
+		"Good AND Bad",
+		"{\"type\":\"and\",\"free\":false,\"members\":["
+			"{\"licence\":\"Good\",\"free\":true},"
+			"{\"licence\":\"Bad\",\"free\":false}"
+		"]}"
+	);
+	test_code(
+		classifier, "Bad OR (Good AND Awesome) OR Awful", 1,
+		"Bad OR (Good AND Awesome) OR Awful",
+		"{\"type\":\"or\",\"free\":true,\"members\":["
+			"{\"licence\":\"Bad\",\"free\":false},"
+			"{\"type\":\"and\",\"free\":true,\"members\":["
+				"{\"licence\":\"Good\",\"free\":true},"
+				"{\"licence\":\"Awesome\",\"free\":true}"
+			"]},"
+			"{\"licence\":\"Awful\",\"free\":false}"
+		"]}"
+	);
+	test_code(
+		classifier, "(Bad OR (Awful AND Good)) AND Good", 0,
+		"(Bad OR (Awful AND Good)) AND Good",
+		"{\"type\":\"and\",\"free\":false,\"members\":["
+			"{\"type\":\"or\",\"free\":false,\"members\":["
+				"{\"licence\":\"Bad\",\"free\":false},"
+				"{\"type\":\"and\",\"free\":false,\"members\":["
+					"{\"licence\":\"Awful\",\"free\":false},"
+					"{\"licence\":\"Good\",\"free\":true}"
+				"]}"
+			"]},"
+			"{\"licence\":\"Good\",\"free\":true}"
+		"]}"
+	);
+
+	// An empty AND must only set the bits of the lists in use, like the classifiers do.
+	const int old_count = opt_licencelistcount;
+	const unsigned char empty_and[] = { 0x00, BYTECODE_HEADER_SIZE + BYTECODE_OP_SIZE, 0x00, 0x01, BYTECODE_AND, 0x00, 0x00 };
+	opt_licencelistcount = 1;
+	assert_int_equal(bytecode_evaluate(empty_and), 1);
+	opt_licencelistcount = 2;
+	assert_int_equal(bytecode_evaluate(empty_and), 3);
+	opt_licencelistcount = old_count;
+
+	opt_colour = old_colour;
+	opt_grammar = old_grammar;
+}
@@ -21,6 +21,7 @@
 #include <setjmp.h>
 #include <cmocka.h>
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -98,6 +99,18 @@ void test__chainbuffer(void **state) {
 		assert_memory_equal(append, buffer, size);
 	}
 
+	// Aligned appends, interleaved with odd-sized strings.
+	for(int i = 0; i < 100; ++i) {
+		const long value = i;
+		long *aligned = chainbuf_appendAligned(cb, &value, sizeof(value));
+		assert_non_null(aligned);
+		assert_int_equal(((uintptr_t)aligned) % _Alignof(max_align_t), 0);
+		assert_int_equal(*aligned, value);
+
+		char *append = chainbuf_append(cb, "xy");
+		assert_string_equal(append, "xy");
+	}
+
 	// Check if nothing bad happened to our earlier appends.
 	assert_string_equal(first_append, first_data);
 	assert_string_equal(second_append, second_data);
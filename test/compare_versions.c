@@ -26,11 +26,11 @@
 #define UNUSED(x) ((void)(x))
 
 #define testcase(a, b, expected) do { \
-	const int result = compare_versions(a, b); \
+	const int result = compare_versions_fallback(a, b); \
 	assert_int_equal(result, expected);  \
 \
 	if(expected) { \
-		const int result_swapped = compare_versions(b, a); \
+		const int result_swapped = compare_versions_fallback(b, a); \
 		assert_int_equal(result_swapped, 0 - expected); \
 	} \
 }while(0)
@@ -38,10 +38,7 @@
 void test__compare_versions(void **state) {
 	UNUSED(state);
 
-#ifdef WITH_LIBRPM
-	// We want to test our fallback mechanism, not librpm's behaviour.
-	skip();
-#else
+	// The fallback is always built, so we can test it even when using librpm.
 	// Some standard version strings.
 	testcase("1.0", "0.9", +1);
 	testcase("1.1", "1.0", +1);
@@ -92,5 +89,27 @@ void test__compare_versions(void **state) {
 	testcase("1.2~3", "1.2^5", -1);
 	testcase("1.2~7", "1.2^5", -1);
 	testcase("1.3~7", "1.2^5", +1);
-#endif
+
+	// Test leading zeroes and empty components.
+	testcase("1.01", "1.1", 0);
+	testcase("1.010", "1.9", +1);
+	testcase("1.0000", "1.0", 0);
+	testcase("1..2", "1.0.2", 0);
+	testcase("1.a", "1.ab", -1);
+
+	// Test components that don't fit in a long int.
+	testcase("1.123456789012345678901234567890", "1.123456789012345678901234567889", +1);
+	testcase("1.99999999999999999999999999999999", "1.100000000000000000000000000000000", -1);
+
+	// Test components longer than the old, fixed-size component buffer.
+	testcase(
+		"1.aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+		"1.aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab",
+		-1
+	);
+	testcase(
+		"1.00000000000000000000000000000000000000000000000000000000000000000000002",
+		"1.00000000000000000000000000000000000000000000000000000000000000000000001",
+		+1
+	);
 }
@@ -87,11 +87,20 @@ int main(int argc, char *argv[]) {
 	str_squeeze_char(input, ' ');
 	str_balance_parentheses(trim(input, NULL), sanitized, (input_len + 256), NULL);
 
+	// Both entry points modify their input, so evaluate() gets a copy.
+	char *evaluated = strdup(sanitized);
+
 	struct LicenceTreeNode *ltn = classifier->classify(classifier, sanitized);
 	if (!ltn) {
 		return -4;
 	}
 
+	// The fast path must always agree with the full classification.
+	if (classifier->evaluate(classifier, evaluated) != ltn->is_free) {
+		abort();
+	}
+	free(evaluated);
+
 	licence_printNode(ltn);
 	putc('\n', stdout);
 
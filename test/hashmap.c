@@ -0,0 +1,82 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The arg/def/jmp includes are required by cmocka.
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+
+#include "src/hashmap.h"
+
+#define UNUSED(x) ((void)(x))
+
+void test__hashmap(void **state) {
+	UNUSED(state);
+
+	struct HashMap *map = hashmap_init(0, 0);
+	assert_non_null(map);
+
+	// Add enough keys to force the map to grow a couple of times.
+	static char keys[1000][8];
+	for(int i = 0; i < 1000; ++i) {
+		snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+
+		struct HashMapEntry *entry = hashmap_insert(map, keys[i]);
+		assert_non_null(entry);
+		assert_int_equal(entry->count, 0);
+		assert_null(entry->data);
+
+		entry->count = i;
+		entry->data = keys[i];
+	}
+	assert_int_equal(map->used, 1000);
+
+	for(int i = 0; i < 1000; ++i) {
+		char key[8];
+		snprintf(key, sizeof(key), "key%d", i);
+
+		struct HashMapEntry *entry = hashmap_find(map, key);
+		assert_non_null(entry);
+		assert_int_equal(entry->count, i);
+		assert_ptr_equal(entry->data, keys[i]);
+
+		// Inserting an existing key should return the same entry.
+		assert_ptr_equal(hashmap_insert(map, key), entry);
+	}
+	assert_int_equal(map->used, 1000);
+
+	assert_null(hashmap_find(map, "key1000"));
+	assert_null(hashmap_find(map, "KEY1"));
+	hashmap_free(map);
+
+	// Case-insensitive maps.
+	map = hashmap_init(16, 1);
+	assert_non_null(map);
+
+	struct HashMapEntry *entry = hashmap_insert(map, "NetworkManager");
+	assert_non_null(entry);
+	entry->count += 1;
+
+	assert_ptr_equal(hashmap_insert(map, "networkmanager"), entry);
+	assert_ptr_equal(hashmap_find(map, "NETWORKMANAGER"), entry);
+	assert_null(hashmap_find(map, "NetworkManager-wifi"));
+	assert_int_equal(map->used, 1);
+	hashmap_free(map);
+}
@@ -0,0 +1,133 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The arg/def/jmp includes are required by cmocka.
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "src/header.h"
+
+#define UNUSED(x) ((void)(x))
+
+struct TestEntry {
+	uint32_t tag, type, count;
+	const void *data;
+	size_t data_len;
+};
+
+static void write_u32(unsigned char *ptr, uint32_t value) {
+	ptr[0] = (value >> 24) & 0xFF;
+	ptr[1] = (value >> 16) & 0xFF;
+	ptr[2] = (value >> 8) & 0xFF;
+	ptr[3] = value & 0xFF;
+}
+
+// Build a header blob, the same way rpm stores it in the database.
+static size_t build_header(unsigned char *buffer, const struct TestEntry *entries, uint32_t count) {
+	unsigned char *index = buffer + 8;
+	unsigned char *data = index + (count * 16);
+
+	uint32_t offset = 0;
+	for(uint32_t i = 0; i < count; ++i) {
+		write_u32(index + (i * 16) + 0, entries[i].tag);
+		write_u32(index + (i * 16) + 4, entries[i].type);
+		write_u32(index + (i * 16) + 8, offset);
+		write_u32(index + (i * 16) + 12, entries[i].count);
+
+		memcpy(data + offset, entries[i].data, entries[i].data_len);
+		offset += entries[i].data_len;
+	}
+
+	write_u32(buffer, count);
+	write_u32(buffer + 4, offset);
+	return 8 + (count * 16) + offset;
+}
+
+void test__header(void **state) {
+	UNUSED(state);
+
+	static const unsigned char epoch[] = { 0x00, 0x00, 0x01, 0x02 };
+	static const char summary[] = "A test package\0Pakiet testowy";
+	const struct TestEntry entries[] = {
+		{ RPMTAG_PUBKEYS, 8, 1, "key", 4 },
+		{ RPMTAG_NAME,    6, 1, "vrms-rpm", 9 },
+		{ RPMTAG_VERSION, 6, 1, "2.3", 4 },
+		{ RPMTAG_EPOCH,   4, 1, epoch, sizeof(epoch) },
+		{ RPMTAG_SUMMARY, 9, 2, summary, sizeof(summary) },
+		{ RPMTAG_RELEASE, 6, 1, "1.fc40", 7 },
+	};
+	const uint32_t entry_count = sizeof(entries) / sizeof(entries[0]);
+
+	unsigned char blob[512];
+	const size_t blob_len = build_header(blob, entries, entry_count);
+
+	struct Header header;
+	assert_int_equal(header_init(&header, blob, blob_len), 0);
+	assert_int_equal(header.index_count, entry_count);
+
+	assert_string_equal(header_getString(&header, RPMTAG_NAME), "vrms-rpm");
+	assert_string_equal(header_getString(&header, RPMTAG_VERSION), "2.3");
+	assert_string_equal(header_getString(&header, RPMTAG_RELEASE), "1.fc40");
+	assert_string_equal(header_getString(&header, RPMTAG_SUMMARY), "A test package");
+	assert_null(header_getString(&header, RPMTAG_LICENSE));
+	assert_null(header_getString(&header, RPMTAG_EPOCH));
+
+	uint32_t value = 0;
+	assert_int_equal(header_getInt32(&header, RPMTAG_EPOCH, &value), 0);
+	assert_int_equal(value, 258);
+	assert_int_equal(header_getInt32(&header, RPMTAG_NAME, &value), -1);
+	assert_int_equal(header_getInt32(&header, RPMTAG_ARCH, &value), -1);
+
+	assert_true(header_hasTag(&header, RPMTAG_PUBKEYS));
+	assert_false(header_hasTag(&header, RPMTAG_ARCH));
+
+	// Looking up several tags at once.
+	const uint32_t tags[] = { RPMTAG_RELEASE, RPMTAG_ARCH, RPMTAG_EPOCH, RPMTAG_NAME };
+	struct HeaderEntry found[4];
+	assert_int_equal(header_findTags(&header, tags, found, 4), 3);
+	assert_string_equal(header_entryString(&header, &found[0]), "1.fc40");
+	assert_int_equal(found[1].type, HEADER_TYPE_NONE);
+	assert_null(header_entryString(&header, &found[1]));
+	assert_int_equal(header_entryInt32(&header, &found[2], &value), 0);
+	assert_int_equal(value, 258);
+	assert_string_equal(header_entryString(&header, &found[3]), "vrms-rpm");
+
+	// Truncated blobs should be rejected.
+	assert_int_equal(header_init(&header, blob, 4), -1);
+	assert_int_equal(header_init(&header, blob, blob_len - 1), -1);
+
+	// Strings that are not terminated before the end of the data store should be rejected.
+	const struct TestEntry unterminated[] = {
+		{ RPMTAG_NAME, 6, 1, "vrms", 4 },
+	};
+	const size_t unterminated_len = build_header(blob, unterminated, 1);
+	assert_int_equal(header_init(&header, blob, unterminated_len), 0);
+	assert_null(header_getString(&header, RPMTAG_NAME));
+
+	// Same goes for integers that stick out past the end.
+	const struct TestEntry short_int[] = {
+		{ RPMTAG_EPOCH, 4, 1, epoch, 2 },
+	};
+	const size_t short_int_len = build_header(blob, short_int, 1);
+	assert_int_equal(header_init(&header, blob, short_int_len), 0);
+	assert_int_equal(header_getInt32(&header, RPMTAG_EPOCH, &value), -1);
+}
@@ -18,6 +18,7 @@
 #include <stdlib.h>
 
 #include "src/buffers.h"
+#include "src/bytecode.h"
 #include "test/licences.h"
 
 static void append_licence(struct LicenceData *data, const char *text) {
@@ -28,7 +29,7 @@ static void append_licence(struct LicenceData *data, const char *text) {
 }
 
 int test_setup__licences(void **state) {
-	struct LicenceData *licences = malloc(sizeof(struct LicenceData));
+	struct LicenceData *licences = calloc(1, sizeof(struct LicenceData));
 	assert_non_null(licences);
 	licences->list = rebuf_init(4 * sizeof(void*));
 	assert_non_null(licences->list);
@@ -39,11 +40,12 @@ int test_setup__licences(void **state) {
 	append_licence(licences, "Good");
 	append_licence(licences, "Long name with spaces");
 
-	struct LicenceClassifier *looseClassifier = classifier_newLoose(licences);
+	const struct LicenceData *lists[] = { licences };
+	struct LicenceClassifier *looseClassifier = classifier_newLoose(lists, 1);
 	assert_non_null(looseClassifier);
-	struct LicenceClassifier *spdxStrictClassifier = classifier_newSPDX(licences, 0);
+	struct LicenceClassifier *spdxStrictClassifier = classifier_newSPDX(lists, 1, 0);
 	assert_non_null(spdxStrictClassifier);
-	struct LicenceClassifier *spdxLenientClassifier = classifier_newSPDX(licences, 1);
+	struct LicenceClassifier *spdxLenientClassifier = classifier_newSPDX(lists, 1, 1);
 	assert_non_null(spdxLenientClassifier);
 
 	struct TestState *ts = malloc(sizeof(struct TestState));
@@ -88,3 +90,67 @@ void assert_ltn_equal(const struct LicenceTreeNode *actual, const struct Licence
 		}
 	}
 }
+
+void test__multipleLists(void **state) {
+	struct TestState *ts = *state;
+
+	struct LicenceData *other = calloc(1, sizeof(struct LicenceData));
+	assert_non_null(other);
+	other->list = rebuf_init(4 * sizeof(void*));
+	assert_non_null(other->list);
+	other->buffer = chainbuf_init(200);
+	assert_non_null(other->buffer);
+
+	append_licence(other, "Good");
+	append_licence(other, "Other");
+
+	const struct LicenceData *lists[] = { ts->data, other };
+	struct LicenceClassifier *classifiers[] = {
+		classifier_newLoose(lists, 2),
+		classifier_newSPDX(lists, 2, 0),
+	};
+
+	for(unsigned int i = 0; i < sizeof(classifiers) / sizeof(classifiers[0]); ++i) {
+		struct LicenceClassifier *c = classifiers[i];
+		assert_non_null(c);
+
+		char buffer[64];
+		#define test_mask(text, expected) do{ \
+			snprintf(buffer, sizeof(buffer), "%s", (text)); \
+			assert_int_equal(c->evaluate(c, buffer), (expected)); \
+		}while(0)
+
+		test_mask("Awesome", 1);
+		test_mask("Good", 3);
+		test_mask("Other", 2);
+		test_mask("Bad", 0);
+		test_mask("Awesome AND Good", 1);
+		test_mask("Awesome OR Other", 3);
+		test_mask("Awesome AND Other", 0);
+		test_mask("(Awesome OR Other) AND Good", 3);
+
+		#undef test_mask
+
+		// The encoded leaves must keep the verdicts for all of the lists, not just the first one.
+		snprintf(buffer, sizeof(buffer), "%s", "Awesome OR Other");
+		struct LicenceTreeNode *tree = c->classify(c, buffer);
+		assert_non_null(tree);
+
+		struct ReBuffer *code = rebuf_init(64);
+		assert_non_null(code);
+		assert_int_equal(bytecode_encode(tree, buffer, code), 0);
+
+		const unsigned char *bytes = code->data;
+		assert_int_equal(bytes[BYTECODE_HEADER_SIZE], BYTECODE_LEAF);
+		assert_int_equal(bytes[BYTECODE_HEADER_SIZE + 1], 1);
+		assert_int_equal(bytes[BYTECODE_HEADER_SIZE + BYTECODE_LEAF_SIZE], BYTECODE_LEAF);
+		assert_int_equal(bytes[BYTECODE_HEADER_SIZE + BYTECODE_LEAF_SIZE + 1], 2);
+		assert_int_equal(bytecode_evaluate(code->data), 3);
+
+		rebuf_free(code);
+		licence_freeTree(tree);
+		c->free(c);
+	}
+
+	licences_free(other);
+}
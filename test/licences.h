@@ -58,6 +58,13 @@ extern void test__spdxStrict_mangledStrings(void **state);
 
 extern void test__spdxLenient(void **state);
 
+extern void test__repodata(void **state);
+extern void test__repodata_countOnly(void **state);
+extern void test__repodata_failOnNonfree(void **state);
+extern void test__packages_longEvr(void **state);
+extern void test__bytecode(void **state);
+extern void test__multipleLists(void **state);
+
 extern void assert_ltn_equal(const struct LicenceTreeNode *actual, const struct LicenceTreeNode *expected, const char *const file, const int line);
 
 #define make_ltn_simple(name, pop_is_free, pop_licence) do{ \
@@ -81,10 +88,13 @@ extern void assert_ltn_equal(const struct LicenceTreeNode *actual, const struct
 } while(0)
 
 // The licence text must be writable, hence we use the buffer[] trick.
+// Both classifier entry points modify the text, so each one gets its own copy.
 #define test_licence(text, expected) do{ \
 	char buffer[] = (text); \
 	struct LicenceTreeNode *ltn = classifier->classify(classifier, buffer); \
 	assert_non_null(ltn); \
+	char evalBuffer[] = (text); \
+	assert_int_equal(classifier->evaluate(classifier, evalBuffer), ltn->is_free); \
 	if((expected) != NULL) { \
 		assert_ltn_equal(ltn, (expected), __FILE__, __LINE__); \
 		licence_freeTree(expected); \
@@ -0,0 +1,138 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The arg/def/jmp includes are required by cmocka.
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+
+#include "src/builtin-licences.h"
+#include "src/licences.h"
+
+#define UNUSED(x) ((void)(x))
+
+static void str_toupper(char *str) {
+	for(; *str != '\0'; ++str) {
+		if((*str >= 'a') && (*str <= 'z')) *str = *str - 'a' + 'A';
+	}
+}
+
+void test__licences_find(void **state) {
+	UNUSED(state);
+
+	struct LicenceData *data = licences_read(BUILTIN_LICENCE_LIST);
+	assert_non_null(data);
+
+	for(int i = 0; i < BUILTIN_LICENCE_COUNT; ++i) {
+		char buffer[256];
+
+		// Every name in the list should be found at its own index.
+		snprintf(buffer, sizeof(buffer), "%s", builtin_licence_names[i]);
+		assert_int_equal(licences_find(data, buffer), i);
+
+		// The lookup should be case-insensitive.
+		str_toupper(buffer);
+		assert_int_equal(licences_find(data, buffer), i);
+
+		// Names extended with some extra chars should not be found.
+		snprintf(buffer, sizeof(buffer), "%s~", builtin_licence_names[i]);
+		assert_int_equal(licences_find(data, buffer), -1);
+		snprintf(buffer, sizeof(buffer), "~%s", builtin_licence_names[i]);
+		assert_int_equal(licences_find(data, buffer), -1);
+	}
+
+	assert_int_equal(licences_find(data, ""), -1);
+	assert_int_equal(licences_find(data, "Definitely not a licence name"), -1);
+
+	licences_free(data);
+}
+
+void test__licences_findSpdx(void **state) {
+	UNUSED(state);
+
+	struct LicenceData *fsfAndOsi = licences_read("spdx-fsf-and-osi");
+	struct LicenceData *fsfOrOsi = licences_read("spdx-fsf-or-osi");
+	struct LicenceData *onlyFsf = licences_read("spdx-only-fsf");
+	struct LicenceData *onlyOsi = licences_read("spdx-only-osi");
+	assert_non_null(fsfAndOsi);
+	assert_non_null(fsfOrOsi);
+	assert_non_null(onlyFsf);
+	assert_non_null(onlyOsi);
+
+	// MIT is marked as both FSF free/libre and OSI approved.
+	assert_true(licences_find(fsfAndOsi, "MIT") >= 0);
+	assert_true(licences_find(fsfOrOsi, "mit") >= 0);
+	assert_true(licences_find(onlyFsf, "MIT") >= 0);
+	assert_true(licences_find(onlyOsi, "MIT") >= 0);
+
+	// Apache-1.0 is FSF free/libre, but not OSI approved.
+	assert_int_equal(licences_find(fsfAndOsi, "Apache-1.0"), -1);
+	assert_true(licences_find(fsfOrOsi, "Apache-1.0") >= 0);
+	assert_true(licences_find(onlyFsf, "Apache-1.0") >= 0);
+	assert_int_equal(licences_find(onlyOsi, "Apache-1.0"), -1);
+
+	// 0BSD is OSI approved, but not FSF free/libre.
+	assert_int_equal(licences_find(fsfAndOsi, "0BSD"), -1);
+	assert_true(licences_find(fsfOrOsi, "0BSD") >= 0);
+	assert_int_equal(licences_find(onlyFsf, "0BSD"), -1);
+	assert_true(licences_find(onlyOsi, "0BSD") >= 0);
+
+	assert_int_equal(licences_find(fsfOrOsi, ""), -1);
+	assert_int_equal(licences_find(fsfOrOsi, "Definitely not a licence name"), -1);
+
+	const struct LicenceData *all[] = { fsfAndOsi, fsfOrOsi, onlyFsf, onlyOsi };
+	assert_int_equal(licences_findMask(all, 4, "MIT"), 0xF);
+	assert_int_equal(licences_findMask(all, 4, "Apache-1.0"), 0x6);
+	assert_int_equal(licences_findMask(all, 4, "0BSD"), 0xA);
+	assert_int_equal(licences_findMask(all, 4, "Unknown"), 0x0);
+
+	licences_free(fsfAndOsi);
+	licences_free(fsfOrOsi);
+	licences_free(onlyFsf);
+	licences_free(onlyOsi);
+}
+
+void test__licences_canonical(void **state) {
+	UNUSED(state);
+
+	assert_string_equal(licences_canonical("GPLv2+"), "GPL-2.0-or-later");
+	assert_string_equal(licences_canonical("gplv2+"), "GPL-2.0-or-later");
+	assert_string_equal(licences_canonical("ASL 2.0"), "Apache-2.0");
+	assert_string_equal(licences_canonical("GPL-3.0"), "GPL-3.0-only");
+
+	// Names without an alias are returned as-is.
+	const char *mit = "MIT";
+	assert_ptr_equal(licences_canonical(mit), mit);
+	const char *unknown = "Definitely not a licence name";
+	assert_ptr_equal(licences_canonical(unknown), unknown);
+
+	// Lists that only know the canonical name should accept the legacy one, too.
+	struct LicenceData *onlyOsi = licences_read("spdx-only-osi");
+	assert_non_null(onlyOsi);
+
+	const struct LicenceData *lists[] = { onlyOsi };
+	assert_int_equal(licences_find(onlyOsi, "ASL 2.0"), -1);
+	assert_int_equal(licences_findMask(lists, 1, "ASL 2.0"), 1);
+	assert_int_equal(licences_findMask(lists, 1, "GPLv3+"), 1);
+	assert_int_equal(licences_findMask(lists, 1, "Boost"), 1);
+	assert_int_equal(licences_findMask(lists, 1, "Definitely not a licence name"), 0);
+
+	licences_free(onlyOsi);
+}
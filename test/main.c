@@ -33,7 +33,14 @@ extern int test_teardown__rebuffer(void **state);
 
 extern void test__compare_versions(void **state);
 extern void test__find_closing_paren(void **state);
+extern void test__hashmap(void **state);
+extern void test__header(void **state);
+extern void test__licences_find(void **state);
+extern void test__licences_findSpdx(void **state);
+extern void test__licences_canonical(void **state);
 extern void test__replace_unicode_spaces(void **state);
+extern void test__snapshot(void **state);
+extern void test__sort_parallel(void **state);
 extern void test__str_balance_parentheses(void **state);
 extern void test__str_compare_with_null_check(void **state);
 extern void test__str_match_first(void **state);
@@ -42,6 +49,7 @@ extern void test__str_ends_with(void **state);
 extern void test__str_split(void **state);
 extern void test__str_squeeze_char(void **state);
 extern void test__trim(void **state);
+extern void test__versions_compareTokens(void **state);
 
 int main(void) {
 	int failures = 0;
@@ -50,7 +58,14 @@ int main(void) {
 		cmocka_unit_test_setup_teardown(test__rebuffer, test_setup__rebuffer, test_teardown__rebuffer),
 		cmocka_unit_test(test__compare_versions),
 		cmocka_unit_test(test__find_closing_paren),
+		cmocka_unit_test(test__hashmap),
+		cmocka_unit_test(test__header),
+		cmocka_unit_test(test__licences_find),
+		cmocka_unit_test(test__licences_findSpdx),
+		cmocka_unit_test(test__licences_canonical),
 		cmocka_unit_test(test__replace_unicode_spaces),
+		cmocka_unit_test(test__snapshot),
+		cmocka_unit_test(test__sort_parallel),
 		cmocka_unit_test(test__str_balance_parentheses),
 		cmocka_unit_test(test__str_compare_with_null_check),
 		cmocka_unit_test(test__str_match_first),
@@ -59,6 +74,7 @@ int main(void) {
 		cmocka_unit_test(test__str_split),
 		cmocka_unit_test(test__str_squeeze_char),
 		cmocka_unit_test(test__trim),
+		cmocka_unit_test(test__versions_compareTokens),
 	};
 	failures += cmocka_run_group_tests(tests, NULL, NULL);
 
@@ -79,6 +95,12 @@ int main(void) {
 		cmocka_unit_test(test__spdxStrict_caseSensitivity),
 		cmocka_unit_test(test__spdxStrict_mangledStrings),
 		cmocka_unit_test(test__spdxLenient),
+		cmocka_unit_test(test__repodata),
+		cmocka_unit_test(test__repodata_countOnly),
+		cmocka_unit_test(test__repodata_failOnNonfree),
+		cmocka_unit_test(test__packages_longEvr),
+		cmocka_unit_test(test__bytecode),
+		cmocka_unit_test(test__multipleLists),
 	};
 	failures += cmocka_run_group_tests(licence_tests, test_setup__licences, test_teardown__licences);
 
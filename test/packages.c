@@ -0,0 +1,59 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+
+#include "src/packages.h"
+#include "src/stats.h"
+#include "test/licences.h"
+
+void test__packages_longEvr(void **state) {
+	struct TestState *ts = *state;
+
+	char good_name[] = "good-package", good_version[] = "1.0", good_release[] = "1", good_licence[] = "Good";
+	struct PackageInfo good = {
+		.name = good_name,
+		.version = good_version,
+		.release = good_release,
+		.licence = good_licence,
+	};
+
+	// An absurdly long version should get the package skipped, without failing the whole run.
+	char *long_version = malloc(8192 + 1);
+	assert_non_null(long_version);
+	memset(long_version, '1', 8192);
+	long_version[8192] = '\0';
+	char long_name[] = "long-version", long_release[] = "1", long_licence[] = "Good";
+	struct PackageInfo bogus = {
+		.name = long_name,
+		.version = long_version,
+		.release = long_release,
+		.licence = long_licence,
+	};
+
+	const unsigned long rejected = stats_counter[STATS_COUNTER_LINES_REJECTED];
+	assert_int_equal(packages_add(&bogus, ts->looseClassifier), 0);
+	assert_int_equal(packages_add(&good, ts->looseClassifier), 0);
+	assert_int_equal(stats_counter[STATS_COUNTER_LINES_REJECTED], rejected + 1);
+
+	int free_count, nonfree_count;
+	packages_getcount(&free_count, &nonfree_count);
+	assert_int_equal(free_count, 1);
+	assert_int_equal(nonfree_count, 0);
+
+	packages_free();
+	free(long_version);
+}
@@ -0,0 +1,201 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef WITH_REPODATA
+#include <zlib.h>
+#endif
+
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "src/options.h"
+#include "src/packages.h"
+#include "src/repodata.h"
+#include "test/licences.h"
+
+static const char primary_xml[] =
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<metadata xmlns=\"http://linux.duke.edu/metadata/common\" xmlns:rpm=\"http://linux.duke.edu/metadata/rpm\" packages=\"4\">\n"
+	"<package type=\"rpm\">\n"
+	"  <name>good-package</name>\n"
+	"  <arch>x86_64</arch>\n"
+	"  <version epoch=\"0\" ver=\"1.0\" rel=\"1.fc39\"/>\n"
+	"  <summary>A package &amp; its summary</summary>\n"
+	"  <format>\n"
+	"    <rpm:license>Good</rpm:license>\n"
+	"    <rpm:provides><rpm:entry name=\"good-package\" flags=\"EQ\" epoch=\"0\" ver=\"1.0\" rel=\"1.fc39\"/></rpm:provides>\n"
+	"  </format>\n"
+	"</package>\n"
+	"<package type=\"rpm\">\n"
+	"  <name>bad-package</name>\n"
+	"  <arch>noarch</arch>\n"
+	"  <version epoch=\"2\" ver=\"3.1\" rel=\"4\"/>\n"
+	"  <summary>Nope</summary>\n"
+	"  <format><rpm:license>Bad</rpm:license></format>\n"
+	"</package>\n"
+	"<package type=\"rpm\">\n"
+	"  <name>compound</name>\n"
+	"  <arch>noarch</arch>\n"
+	"  <version epoch=\"0\" ver=\"2\" rel=\"1\"/>\n"
+	"  <format><rpm:license>Good and (Awesome or Bad)</rpm:license></format>\n"
+	"</package>\n"
+	// Different prefix for the same namespace.
+	"<package type=\"rpm\" xmlns:r=\"http://linux.duke.edu/metadata/rpm\">\n"
+	"  <name>prefixed</name>\n"
+	"  <arch>noarch</arch>\n"
+	"  <version epoch=\"0\" ver=\"2\" rel=\"1\"/>\n"
+	"  <format><r:license>Long name with spaces</r:license></format>\n"
+	"</package>\n"
+	"</metadata>\n";
+
+static void check_counts(const int result) {
+	assert_int_equal(result, 4);
+
+	int free, nonfree;
+	packages_getcount(&free, &nonfree);
+	assert_int_equal(free, 3);
+	assert_int_equal(nonfree, 1);
+
+	packages_free();
+}
+
+void test__repodata(void **state) {
+#ifndef WITH_REPODATA
+	(void)state;
+	skip();
+#else
+	struct TestState *ts = *state;
+	opt_describe = 1;
+
+	// Plain XML.
+	FILE *file = tmpfile();
+	assert_non_null(file);
+	fputs(primary_xml, file);
+	rewind(file);
+	check_counts(repodata_readFile(file, ts->looseClassifier));
+	fclose(file);
+
+	// Gzipped XML.
+	file = tmpfile();
+	assert_non_null(file);
+	gzFile gz = gzdopen(dup(fileno(file)), "wb");
+	assert_non_null(gz);
+	assert_int_equal(gzputs(gz, primary_xml), sizeof(primary_xml) - 1);
+	gzclose(gz);
+	rewind(file);
+	check_counts(repodata_readFile(file, ts->looseClassifier));
+	fclose(file);
+
+#ifdef WITH_ZSTD
+	// Zstd-compressed XML. The trailing comment makes the (single) block bigger
+	// than the parser's read size, so the decoder has to flush buffered output
+	// across several reads.
+	const size_t padding = 96 * 1024;
+	const size_t xml_len = sizeof(primary_xml) - 1 + padding + 8;
+	char *xml = malloc(xml_len + 1);
+	assert_non_null(xml);
+	strcpy(xml, primary_xml);
+	strcat(xml, "<!--");
+	char *end = xml + strlen(xml);
+	memset(end, 'x', padding);
+	strcpy(end + padding, "-->\n");
+	assert_int_equal(strlen(xml), xml_len);
+
+	const size_t zst_capacity = ZSTD_compressBound(xml_len);
+	char *zst = malloc(zst_capacity);
+	assert_non_null(zst);
+	const size_t zst_len = ZSTD_compress(zst, zst_capacity, xml, xml_len, 3);
+	assert_false(ZSTD_isError(zst_len));
+
+	file = tmpfile();
+	assert_non_null(file);
+	assert_int_equal(fwrite(zst, 1, zst_len, file), zst_len);
+	rewind(file);
+	check_counts(repodata_readFile(file, ts->looseClassifier));
+	fclose(file);
+	free(zst);
+	free(xml);
+#endif
+
+	// Truncated XML.
+	file = tmpfile();
+	assert_non_null(file);
+	fwrite(primary_xml, 1, sizeof(primary_xml) / 2, file);
+	rewind(file);
+	assert_int_equal(repodata_readFile(file, ts->looseClassifier), REPODATA_READ_FAILED);
+	fclose(file);
+
+	opt_describe = 0;
+#endif
+}
+
+void test__repodata_countOnly(void **state) {
+#ifndef WITH_REPODATA
+	(void)state;
+	skip();
+#else
+	struct TestState *ts = *state;
+	const int old_list = opt_list;
+	opt_list = 0;
+
+	// Packages are only counted, but the totals must be the same.
+	FILE *file = tmpfile();
+	assert_non_null(file);
+	fputs(primary_xml, file);
+	rewind(file);
+	check_counts(repodata_readFile(file, ts->looseClassifier));
+	fclose(file);
+
+	opt_list = old_list;
+#endif
+}
+
+void test__repodata_failOnNonfree(void **state) {
+#ifndef WITH_REPODATA
+	(void)state;
+	skip();
+#else
+	struct TestState *ts = *state;
+	opt_failonnonfree = OPT_FAIL_COUNT;
+	opt_failthreshold = 1;
+
+	FILE *file = tmpfile();
+	assert_non_null(file);
+	fputs(primary_xml, file);
+	rewind(file);
+
+	// Reading should stop right after the first non-free package.
+	assert_int_equal(repodata_readFile(file, ts->looseClassifier), 2);
+	assert_true(packages_shouldStop());
+
+	int free, nonfree;
+	packages_getcount(&free, &nonfree);
+	assert_int_equal(free, 1);
+	assert_int_equal(nonfree, 1);
+
+	packages_free();
+	fclose(file);
+
+	opt_failonnonfree = OPT_FAIL_NEVER;
+	assert_false(packages_shouldStop());
+#endif
+}
@@ -0,0 +1,98 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The arg/def/jmp includes are required by cmocka.
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "src/snapshot.h"
+
+#define UNUSED(x) ((void)(x))
+
+static const struct SnapshotEntry entries[] = {
+	{ .name = "bash", .epoch = NULL, .version = "5.2.26", .release = "3.fc40", .arch = "x86_64", .licence = "GPL-3.0-or-later", .is_free = 1 },
+	{ .name = "gpg-pubkey", .epoch = NULL, .version = "a15b79cc", .release = "63d04c2c", .arch = NULL, .licence = "pubkey", .is_free = 1 },
+	{ .name = "steam", .epoch = "1", .version = "1.0.0.79", .release = "2.fc40", .arch = "i686", .licence = "Steam License Agreement", .is_free = 0 },
+};
+#define ENTRY_COUNT (sizeof(entries) / sizeof(entries[0]))
+
+static void check_entry(const struct SnapshotEntry *expected, const struct SnapshotEntry *actual) {
+	assert_string_equal(actual->name, expected->name);
+	if(expected->epoch != NULL)
+		assert_string_equal(actual->epoch, expected->epoch);
+	else
+		assert_null(actual->epoch);
+	assert_string_equal(actual->version, expected->version);
+	assert_string_equal(actual->release, expected->release);
+	if(expected->arch != NULL)
+		assert_string_equal(actual->arch, expected->arch);
+	else
+		assert_null(actual->arch);
+	assert_string_equal(actual->licence, expected->licence);
+	assert_int_equal(actual->is_free, expected->is_free);
+	assert_non_null(actual->evr);
+}
+
+void test__snapshot(void **state) {
+	UNUSED(state);
+
+	char path[64];
+	snprintf(path, sizeof(path), "/tmp/vrms-rpm-test-%ld.snapshot", (long)getpid());
+
+	struct SnapshotWriter *writer = snapshot_create(path, ENTRY_COUNT);
+	assert_non_null(writer);
+	for(size_t i = 0; i < ENTRY_COUNT; ++i) assert_int_equal(snapshot_append(writer, &entries[i]), 0);
+	assert_int_equal(snapshot_append(writer, &entries[0]), -1);
+	assert_int_equal(snapshot_close(writer), 0);
+
+	struct Snapshot *snapshot = snapshot_read(path, 1);
+	assert_non_null(snapshot);
+	assert_int_equal(snapshot->count, ENTRY_COUNT);
+	for(size_t i = 0; i < ENTRY_COUNT; ++i) check_entry(&entries[i], &snapshot->entries[i]);
+	snapshot_free(snapshot);
+
+	// Without tokenising, the EVRs should be left empty.
+	snapshot = snapshot_read(path, 0);
+	assert_non_null(snapshot);
+	assert_int_equal(snapshot->count, ENTRY_COUNT);
+	assert_null(snapshot->entries[0].evr);
+	snapshot_free(snapshot);
+
+	// Writing fewer entries than announced should be reported as an error...
+	writer = snapshot_create(path, ENTRY_COUNT);
+	assert_non_null(writer);
+	assert_int_equal(snapshot_append(writer, &entries[0]), 0);
+	assert_int_equal(snapshot_close(writer), -1);
+
+	// ...and the resulting file should be rejected.
+	assert_null(snapshot_read(path, 1));
+
+	// Same goes for files that aren't snapshots at all.
+	FILE *file = fopen(path, "wb");
+	assert_non_null(file);
+	fputs("VRMSSNP1 but not really", file);
+	fclose(file);
+	assert_null(snapshot_read(path, 1));
+
+	unlink(path);
+}
@@ -0,0 +1,77 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The arg/def/jmp includes are required by cmocka.
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/sort.h"
+
+#define UNUSED(x) ((void)(x))
+
+// Sort by key only, with the position as a tie-breaker, as packages_sort() does.
+struct Item {
+	unsigned int key;
+	unsigned int position;
+};
+
+static int compare_items(const void *A, const void *B) {
+	const struct Item *a = A;
+	const struct Item *b = B;
+	if(a->key != b->key) return (a->key > b->key) ? +1 : -1;
+	return (a->position > b->position) - (a->position < b->position);
+}
+
+static void testcase(const size_t count, const unsigned int threads) {
+	struct Item *serial = test_malloc((count + 1) * sizeof(struct Item));
+	struct Item *parallel = test_malloc((count + 1) * sizeof(struct Item));
+
+	// Use a small key range, so there are plenty of duplicates.
+	unsigned int state = 12345;
+	for(size_t i = 0; i < count; ++i) {
+		state = (state * 1103515245) + 12345;
+		serial[i] = (struct Item){ .key = (state >> 16) % 1000, .position = i };
+	}
+	memcpy(parallel, serial, count * sizeof(struct Item));
+
+	qsort(serial, count, sizeof(struct Item), &compare_items);
+	assert_int_equal(sort_parallel(parallel, count, sizeof(struct Item), &compare_items, threads), 0);
+	assert_memory_equal(serial, parallel, count * sizeof(struct Item));
+
+	test_free(parallel);
+	test_free(serial);
+}
+
+void test__sort_parallel(void **state) {
+	UNUSED(state);
+
+	testcase(0, 4);
+	testcase(1, 4);
+	testcase(3, 4);
+	testcase(1000, 1);
+	testcase(1000, 2);
+	testcase(1000, 3);
+	testcase(100000, 4);
+	testcase(100001, 7);
+	testcase(100000, 16);
+	testcase(100000, 64);
+}
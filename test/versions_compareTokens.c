@@ -0,0 +1,137 @@
+/**
+ * vrms-rpm - list non-free packages on an rpm-based Linux distribution
+ * Copyright (C) 2024 suve (a.k.a. Artur Frenszek-Iwicki)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program (LICENCE.txt). If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The arg/def/jmp includes are required by cmocka.
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "src/versions.h"
+
+#define UNUSED(x) ((void)(x))
+
+static int compare(const char *epoch_a, const char *a, const char *epoch_b, const char *b) {
+	unsigned char tokens_a[256], tokens_b[256];
+	assert_int_not_equal(versions_tokenise(epoch_a, a, "1", tokens_a, sizeof(tokens_a)), 0);
+	assert_int_not_equal(versions_tokenise(epoch_b, b, "1", tokens_b, sizeof(tokens_b)), 0);
+	return versions_compareTokens(tokens_a, tokens_b);
+}
+
+#define testcase_epoch(epoch_a, a, epoch_b, b, expected) do { \
+	assert_int_equal(compare(epoch_a, a, epoch_b, b), expected); \
+	assert_int_equal(compare(epoch_b, b, epoch_a, a), 0 - expected); \
+} while(0)
+
+#define testcase(a, b, expected) testcase_epoch(NULL, a, NULL, b, expected)
+
+void test__versions_compareTokens(void **state) {
+	UNUSED(state);
+
+	// Test cases taken from rpm's own test suite for rpmvercmp().
+	testcase("1.0", "1.0", 0);
+	testcase("1.0", "2.0", -1);
+	testcase("2.0.1", "2.0.1", 0);
+	testcase("2.0", "2.0.1", -1);
+	testcase("2.0.1a", "2.0.1a", 0);
+	testcase("2.0.1a", "2.0.1", +1);
+	testcase("5.5p1", "5.5p1", 0);
+	testcase("5.5p1", "5.5p2", -1);
+	testcase("5.5p10", "5.5p10", 0);
+	testcase("5.5p1", "5.5p10", -1);
+	testcase("10xyz", "10.1xyz", -1);
+	testcase("xyz10", "xyz10", 0);
+	testcase("xyz10", "xyz10.1", -1);
+	testcase("xyz.4", "xyz.4", 0);
+	testcase("xyz.4", "8", -1);
+	testcase("xyz.4", "2", -1);
+	testcase("5.5p2", "5.6p1", -1);
+	testcase("5.6p1", "6.5p1", -1);
+	testcase("6.0.rc1", "6.0", +1);
+	testcase("10b2", "10a1", +1);
+	testcase("10a2", "10b2", -1);
+	testcase("1.0aa", "1.0aa", 0);
+	testcase("1.0a", "1.0aa", -1);
+	testcase("10.0001", "10.0001", 0);
+	testcase("10.0001", "10.1", 0);
+	testcase("10.0001", "10.0039", -1);
+	testcase("4.999.9", "5.0", -1);
+	testcase("20101121", "20101121", 0);
+	testcase("20101121", "20101122", -1);
+	testcase("2_0", "2_0", 0);
+	testcase("2.0", "2_0", 0);
+	testcase("a", "a", 0);
+	testcase("a+", "a+", 0);
+	testcase("a+", "a_", 0);
+	testcase("+a", "+a", 0);
+	testcase("+a", "_a", 0);
+	testcase("+_", "+_", 0);
+	testcase("_+", "+_", 0);
+	testcase("+", "_", 0);
+
+	// Tilde and caret.
+	testcase("1.0~rc1", "1.0~rc1", 0);
+	testcase("1.0~rc1", "1.0", -1);
+	testcase("1.0~rc1", "1.0~rc2", -1);
+	testcase("1.0~rc1~git123", "1.0~rc1~git123", 0);
+	testcase("1.0~rc1~git123", "1.0~rc1", -1);
+	testcase("1.0^", "1.0^", 0);
+	testcase("1.0^", "1.0", +1);
+	testcase("1.0^git1", "1.0^git1", 0);
+	testcase("1.0^git1", "1.0", +1);
+	testcase("1.0^git1", "1.0^git2", -1);
+	testcase("1.0^git1", "1.01", -1);
+	testcase("1.0^20160101", "1.0^20160101", 0);
+	testcase("1.0^20160101", "1.0.1", -1);
+	testcase("1.0^20160101^git1", "1.0^20160101^git1", 0);
+	testcase("1.0^20160102", "1.0^20160101^git1", +1);
+	testcase("1.0~rc1^git1", "1.0~rc1^git1", 0);
+	testcase("1.0~rc1^git1", "1.0~rc1", +1);
+	testcase("1.0^git1~pre", "1.0^git1~pre", 0);
+	testcase("1.0^git1", "1.0^git1~pre", +1);
+
+	// Numeric segments of any length.
+	testcase("1.123456789012345678901234567890", "1.123456789012345678901234567889", +1);
+	testcase("1.000000000000000000000000000000000000000000000000000000000000000000000001", "1.1", 0);
+
+	// Packages without an epoch sort before those with one, regardless of the version.
+	testcase_epoch(NULL, "2.0", "0", "1.0", -1);
+	testcase_epoch("1", "1.0", "2", "0.1", -1);
+	testcase_epoch("1", "1.0", "1", "1.0", 0);
+	testcase_epoch("10", "1.0", "9", "2.0", +1);
+
+	// The release is compared after the version.
+	unsigned char a[64], b[64];
+	assert_int_not_equal(versions_tokenise(NULL, "1.0", "2.fc39", a, sizeof(a)), 0);
+	assert_int_not_equal(versions_tokenise(NULL, "1.0", "10.fc39", b, sizeof(b)), 0);
+	assert_int_equal(versions_compareTokens(a, b), -1);
+	assert_int_equal(versions_compareTokens(b, a), +1);
+
+	// The version and release must not be mixed up.
+	assert_int_not_equal(versions_tokenise(NULL, "1.0.1", "1", a, sizeof(a)), 0);
+	assert_int_not_equal(versions_tokenise(NULL, "1.0", "1.1", b, sizeof(b)), 0);
+	assert_int_equal(versions_compareTokens(a, b), +1);
+
+	// Too small a buffer.
+	assert_int_equal(versions_tokenise(NULL, "1.0", "1", a, 4), 0);
+
+	// Alternating letters and digits are the worst case for the size of the tokens.
+	unsigned char worst[TOKENISED_EVR_MAX_SIZE(3, 8, 8)];
+	assert_int_not_equal(versions_tokenise("1a2", "a15b79cc", "63d04c2c", worst, sizeof(worst)), 0);
+}
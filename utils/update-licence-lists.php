@@ -107,7 +107,19 @@ function update_fedora() {
 	$fedoraData = read_json_file($fedoraSourceUrl);
 
 	$list = [];
+	$aliasTargets = [];
 	foreach($fedoraData as $licence) {
+		// Legacy abbreviations map to SPDX identifiers no matter whether the licence is allowed.
+		// Only simple identifiers are used as alias targets - not whole expressions.
+		$spdxExpr = get_nested_value($licence, 'license', 'expression');
+		$legacyAbbrevs = get_nested_value($licence, 'fedora', 'legacy-abbreviation');
+		if(($spdxExpr !== NULL) && ($legacyAbbrevs !== NULL) && !str_contains($spdxExpr, " ")) {
+			foreach($legacyAbbrevs as $abbrev) {
+				if(strcasecmp($abbrev, $spdxExpr) === 0) continue;
+				$aliasTargets[strtolower($abbrev)][$spdxExpr] = $abbrev;
+			}
+		}
+
 		if(!allowed_in_fedora($licence)) continue;
 
 		// The proper way
@@ -129,6 +141,15 @@ function update_fedora() {
 
 	uniqsort($list);
 	write_to_file('../licences/fedora.txt', $list);
+
+	// Some abbreviations were used for more than one licence (e.g. "LGPLv2+").
+	// These cannot be mapped to a single identifier, so they are left out.
+	$aliases = [];
+	foreach($aliasTargets as $targets) {
+		if(count($targets) !== 1) continue;
+		foreach($targets as $target => $abbrev) $aliases[$abbrev] = $target;
+	}
+	return $aliases;
 }
 
 function array_key_is_true($array, $key) {
@@ -140,42 +161,70 @@ function update_spdx() {
 	$spdxSourceUrl = 'https://raw.githubusercontent.com/spdx/license-list-data/main/json/licenses.json';
 	$spdxData = read_json_file($spdxSourceUrl);
 
-	$fsfOnly = [];
-	$osiOnly = [];
 	$either = [];
-	$both = [];
+	$flags = [];
+	$deprecated = [];
+	$known = [];
 
 	foreach($spdxData['licenses'] as $licence) {
 		$identifier = $licence['licenseId'];
 		$fsfApproved = array_key_is_true($licence, 'isFsfLibre');
 		$osiApproved = array_key_is_true($licence, 'isOsiApproved');
+		$isDeprecated = array_key_is_true($licence, 'isDeprecatedLicenseId');
 
-		if($fsfApproved) $fsfOnly[] = $identifier;
-		if($osiApproved) $osiOnly[] = $identifier;
-		if($fsfApproved || $osiApproved) $either[] = $identifier;
-		if($fsfApproved && $osiApproved) $both[] = $identifier;
-	}
+		$known[$identifier] = true;
+		if($isDeprecated) $deprecated[] = $identifier;
 
-	sort($fsfOnly, SORT_STRING | SORT_FLAG_CASE);
-	write_to_file('../licences/spdx-only-fsf.txt', $fsfOnly);
+		// Licences approved by neither are not accepted by any of the SPDX lists,
+		// so there's no point in putting them in the index.
+		if(!$fsfApproved && !$osiApproved) continue;
 
-	sort($osiOnly, SORT_STRING | SORT_FLAG_CASE);
-	write_to_file('../licences/spdx-only-osi.txt', $osiOnly);
+		$either[] = $identifier;
+		$flags[$identifier] = ($fsfApproved ? 'F' : '-') . ($osiApproved ? 'O' : '-') . ($isDeprecated ? 'D' : '-');
+	}
 
 	sort($either, SORT_STRING | SORT_FLAG_CASE);
-	write_to_file('../licences/spdx-fsf-or-osi.txt', $either);
 
-	sort($both, SORT_STRING | SORT_FLAG_CASE);
-	write_to_file('../licences/spdx-fsf-and-osi.txt', $both);
+	// The spdx-* licence lists are built from this file - see src/generate-spdx-index.sh.
+	$index = [
+		'# This file has been generated by utils/update-licence-lists.php.',
+		'# Flags: F - FSF free/libre, O - OSI approved, D - deprecated identifier.',
+	];
+	foreach($either as $identifier) {
+		$index[] = $flags[$identifier] . "\t" . $identifier;
+	}
+	write_to_file('../licences/spdx-index.tsv', $index);
+
+	// Most deprecated identifiers have been split into "-only" and "-or-later" variants,
+	// with "+" being the old way of saying "or later".
+	$aliases = [];
+	foreach($deprecated as $identifier) {
+		$target = str_ends_with($identifier, '+')
+			? substr($identifier, 0, -1) . '-or-later'
+			: $identifier . '-only';
+		if(array_key_exists($target, $known)) $aliases[$identifier] = $target;
+	}
 
 	return [
-		'fsfOnly' => $fsfOnly,
-		'osiOnly' => $osiOnly,
 		'either' => $either,
-		'both' => $both,
+		'aliases' => $aliases,
 	];
 }
 
+function update_aliases(...$aliasLists) {
+	$aliases = array_merge(...$aliasLists);
+	uksort($aliases, 'strcasecmp');
+
+	$lines = [
+		'# This file has been generated by utils/update-licence-lists.php.',
+		'# Maps legacy and deprecated licence names to their canonical SPDX identifiers.',
+	];
+	foreach($aliases as $alias => $target) {
+		$lines[] = $alias . "\t" . $target;
+	}
+	write_to_file('../licences/spdx-aliases.tsv', $lines);
+}
+
 // SUSE licensing guidelines say to use SPDX identifiers.
 // The spreadsheet exists mostly to list licenses that do not
 // have an SPDX identifier yet, plus some legacy identifiers.
@@ -236,8 +285,8 @@ function update_suse($spdxData) {
 	write_to_file('../licences/suse.txt', $list);
 }
 
-function update_tweaked() {
-	$combined = [];
+function update_tweaked($spdxData) {
+	$combined = $spdxData;
 
 	$files = glob('../licences/*.txt', GLOB_NOSORT);
 	foreach($files as $file) {
@@ -257,8 +306,10 @@ function update_tweaked() {
 chdir(__DIR__);
 $spdx = update_spdx();
 
-update_fedora();
+$fedoraAliases = update_fedora();
 update_suse($spdx['either']);
 
-update_tweaked();
+update_aliases($spdx['aliases'], $fedoraAliases);
+
+update_tweaked($spdx['either']);
 